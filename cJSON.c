@@ -158,6 +158,7 @@ typedef struct internal_hooks
     void *(CJSON_CDECL *allocate)(size_t size);
     void (CJSON_CDECL *deallocate)(void *pointer);
     void *(CJSON_CDECL *reallocate)(void *pointer, size_t size);
+    cJSON_Arena *arena; /* when set, parsing allocates from it instead */
 } internal_hooks;
 
 #if defined(_MSC_VER)
@@ -183,7 +184,58 @@ static void * CJSON_CDECL internal_realloc(void *pointer, size_t size)
 /* strlen of character literals resolved at compile time */
 #define static_strlen(string_literal) (sizeof(string_literal) - sizeof(""))
 
-static internal_hooks global_hooks = { internal_malloc, internal_free, internal_realloc };
+static internal_hooks global_hooks = { internal_malloc, internal_free, internal_realloc, NULL };
+
+/* keep every arena allocation suitably aligned for cJSON items */
+#define ARENA_ALIGNMENT sizeof(double)
+
+static void *arena_allocate(cJSON_Arena * const arena, size_t size)
+{
+    size_t start = (arena->used + (ARENA_ALIGNMENT - 1)) & ~(ARENA_ALIGNMENT - 1);
+
+    if ((start < arena->used) || (start > arena->size) || (size > (arena->size - start)))
+    {
+        return NULL;
+    }
+
+    arena->last = start;
+    arena->used = start + size;
+
+    return arena->buffer + start;
+}
+
+/* parsing allocates through these, so that it works the same with and without an arena */
+static void *hooks_allocate(const internal_hooks * const hooks, size_t size)
+{
+    if (hooks->arena != NULL)
+    {
+        return arena_allocate(hooks->arena, size);
+    }
+
+    return hooks->allocate(size);
+}
+
+static void hooks_deallocate(const internal_hooks * const hooks, void *pointer)
+{
+    if (hooks->arena == NULL)
+    {
+        hooks->deallocate(pointer);
+    }
+    else if ((unsigned char*)pointer == (hooks->arena->buffer + hooks->arena->last))
+    {
+        /* only the most recent allocation can be given back, e.g. temporary number buffers */
+        hooks->arena->used = hooks->arena->last;
+    }
+}
+
+static void hooks_delete(cJSON *item, const internal_hooks * const hooks)
+{
+    /* items in an arena are released all at once by rolling it back */
+    if (hooks->arena == NULL)
+    {
+        cJSON_Delete(item);
+    }
+}
 
 static unsigned char* cJSON_strdup(const unsigned char* string, const internal_hooks * const hooks)
 {
@@ -240,7 +292,7 @@ CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
 /* Internal constructor. */
 static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
 {
-    cJSON* node = (cJSON*)hooks->allocate(sizeof(cJSON));
+    cJSON* node = (cJSON*)hooks_allocate(hooks, sizeof(cJSON));
     if (node)
     {
         memset(node, '\0', sizeof(cJSON));
@@ -249,6 +301,29 @@ static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
     return node;
 }
 
+/* Open addressing hash table over the members of an object. Keys are hashed case-folded, so that one
+ * index serves both case sensitive and insensitive lookups. Members are inserted in list order with
+ * linear probing, so the first match found in a probe sequence is also the first one in the list. */
+typedef struct cJSON_Index
+{
+    size_t mask; /* number of slots - 1, a power of 2 */
+    size_t count;
+    struct
+    {
+        size_t hash;
+        cJSON *item;
+    } slots[1];
+} cJSON_Index;
+
+/* markers stored in cJSON.index: objects that are never indexed (arena documents),
+ * and objects that cannot be indexed until their members change */
+static cJSON_Index index_never;
+static cJSON_Index index_none;
+#define INDEX_NEVER (&index_never)
+#define INDEX_NONE (&index_none)
+
+static void drop_index(cJSON * const object);
+
 /* Delete a cJSON structure. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
 {
@@ -270,6 +345,7 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
             global_hooks.deallocate(item->string);
             item->string = NULL;
         }
+        drop_index(item);
         global_hooks.deallocate(item);
         item = next;
     }
@@ -293,6 +369,7 @@ typedef struct
     size_t offset;
     size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
     internal_hooks hooks;
+    cJSON_bool in_situ; /* unescape strings inside content, which is writable then */
 } parse_buffer;
 
 /* check if the given size is left to read in a given parse buffer (starting with 1) */
@@ -303,84 +380,1034 @@ typedef struct
 /* get a pointer to the buffer at the position */
 #define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
 
-/* Parse the input text to generate a number, and populate the result into item. */
-static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+/* Fast number parsing: the decimal mantissa (up to 19 significant digits) and
+ * exponent are converted directly to the nearest double with the Eisel-Lemire
+ * algorithm, which only needs a 64x128 bit multiplication by a truncated power
+ * of five. Small exact cases skip even that. The few inputs where the result
+ * can't be decided that way (more than 19 digits that straddle a rounding
+ * boundary) fall back to strtod, so results always match a correctly rounded
+ * strtod. Define CJSON_NO_FAST_NUMBERS to always use strtod, and sprintf to
+ * print (see print_double). */
+#if defined(_MSC_VER)
+typedef unsigned __int64 cjson_uint64;
+#define CJSON_HAVE_UINT64 1
+#elif defined(__GNUC__)
+__extension__ typedef unsigned long long cjson_uint64;
+#define CJSON_HAVE_UINT64 1
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L)
+typedef unsigned long long cjson_uint64;
+#define CJSON_HAVE_UINT64 1
+#else
+typedef unsigned long cjson_uint64; /* only used while scanning (and by tapes), strtod does the conversion */
+#endif
+
+#if defined(CJSON_HAVE_UINT64) && !defined(CJSON_NO_FAST_NUMBERS)
+#define CJSON_FAST_NUMBERS 1
+#endif
+
+#ifdef CJSON_FAST_NUMBERS
+#define CJSON_U64(high, low) ((((cjson_uint64)(high)) << 32) | (cjson_uint64)(low))
+
+/* double operations are rounded once, straight to double (no x87 extended precision) */
+#if (defined(__FLT_EVAL_METHOD__) && (__FLT_EVAL_METHOD__ == 0)) || defined(_M_X64) || defined(_M_ARM64)
+#define CJSON_EXACT_DOUBLE_ARITHMETIC 1
+#endif
+
+#define POWER_OF_FIVE_MIN (-342)
+#define POWER_OF_FIVE_MAX 308
+
+/* 5^q for q in [-342, 308], normalized and truncated to 128 bits (high word first) */
+static const cjson_uint64 power_of_five_128[] =
+{
+    CJSON_U64(0xeef453d6, 0x923bd65a), CJSON_U64(0x113faa29, 0x06a13b3f),
+    CJSON_U64(0x9558b466, 0x1b6565f8), CJSON_U64(0x4ac7ca59, 0xa424c507),
+    CJSON_U64(0xbaaee17f, 0xa23ebf76), CJSON_U64(0x5d79bcf0, 0x0d2df649),
+    CJSON_U64(0xe95a99df, 0x8ace6f53), CJSON_U64(0xf4d82c2c, 0x107973dc),
+    CJSON_U64(0x91d8a02b, 0xb6c10594), CJSON_U64(0x79071b9b, 0x8a4be869),
+    CJSON_U64(0xb64ec836, 0xa47146f9), CJSON_U64(0x9748e282, 0x6cdee284),
+    CJSON_U64(0xe3e27a44, 0x4d8d98b7), CJSON_U64(0xfd1b1b23, 0x08169b25),
+    CJSON_U64(0x8e6d8c6a, 0xb0787f72), CJSON_U64(0xfe30f0f5, 0xe50e20f7),
+    CJSON_U64(0xb208ef85, 0x5c969f4f), CJSON_U64(0xbdbd2d33, 0x5e51a935),
+    CJSON_U64(0xde8b2b66, 0xb3bc4723), CJSON_U64(0xad2c7880, 0x35e61382),
+    CJSON_U64(0x8b16fb20, 0x3055ac76), CJSON_U64(0x4c3bcb50, 0x21afcc31),
+    CJSON_U64(0xaddcb9e8, 0x3c6b1793), CJSON_U64(0xdf4abe24, 0x2a1bbf3d),
+    CJSON_U64(0xd953e862, 0x4b85dd78), CJSON_U64(0xd71d6dad, 0x34a2af0d),
+    CJSON_U64(0x87d4713d, 0x6f33aa6b), CJSON_U64(0x8672648c, 0x40e5ad68),
+    CJSON_U64(0xa9c98d8c, 0xcb009506), CJSON_U64(0x680efdaf, 0x511f18c2),
+    CJSON_U64(0xd43bf0ef, 0xfdc0ba48), CJSON_U64(0x0212bd1b, 0x2566def2),
+    CJSON_U64(0x84a57695, 0xfe98746d), CJSON_U64(0x014bb630, 0xf7604b57),
+    CJSON_U64(0xa5ced43b, 0x7e3e9188), CJSON_U64(0x419ea3bd, 0x35385e2d),
+    CJSON_U64(0xcf42894a, 0x5dce35ea), CJSON_U64(0x52064cac, 0x828675b9),
+    CJSON_U64(0x818995ce, 0x7aa0e1b2), CJSON_U64(0x7343efeb, 0xd1940993),
+    CJSON_U64(0xa1ebfb42, 0x19491a1f), CJSON_U64(0x1014ebe6, 0xc5f90bf8),
+    CJSON_U64(0xca66fa12, 0x9f9b60a6), CJSON_U64(0xd41a26e0, 0x77774ef6),
+    CJSON_U64(0xfd00b897, 0x478238d0), CJSON_U64(0x8920b098, 0x955522b4),
+    CJSON_U64(0x9e20735e, 0x8cb16382), CJSON_U64(0x55b46e5f, 0x5d5535b0),
+    CJSON_U64(0xc5a89036, 0x2fddbc62), CJSON_U64(0xeb2189f7, 0x34aa831d),
+    CJSON_U64(0xf712b443, 0xbbd52b7b), CJSON_U64(0xa5e9ec75, 0x01d523e4),
+    CJSON_U64(0x9a6bb0aa, 0x55653b2d), CJSON_U64(0x47b233c9, 0x2125366e),
+    CJSON_U64(0xc1069cd4, 0xeabe89f8), CJSON_U64(0x999ec0bb, 0x696e840a),
+    CJSON_U64(0xf148440a, 0x256e2c76), CJSON_U64(0xc00670ea, 0x43ca250d),
+    CJSON_U64(0x96cd2a86, 0x5764dbca), CJSON_U64(0x38040692, 0x6a5e5728),
+    CJSON_U64(0xbc807527, 0xed3e12bc), CJSON_U64(0xc6050837, 0x04f5ecf2),
+    CJSON_U64(0xeba09271, 0xe88d976b), CJSON_U64(0xf7864a44, 0xc633682e),
+    CJSON_U64(0x93445b87, 0x31587ea3), CJSON_U64(0x7ab3ee6a, 0xfbe0211d),
+    CJSON_U64(0xb8157268, 0xfdae9e4c), CJSON_U64(0x5960ea05, 0xbad82964),
+    CJSON_U64(0xe61acf03, 0x3d1a45df), CJSON_U64(0x6fb92487, 0x298e33bd),
+    CJSON_U64(0x8fd0c162, 0x06306bab), CJSON_U64(0xa5d3b6d4, 0x79f8e056),
+    CJSON_U64(0xb3c4f1ba, 0x87bc8696), CJSON_U64(0x8f48a489, 0x9877186c),
+    CJSON_U64(0xe0b62e29, 0x29aba83c), CJSON_U64(0x331acdab, 0xfe94de87),
+    CJSON_U64(0x8c71dcd9, 0xba0b4925), CJSON_U64(0x9ff0c08b, 0x7f1d0b14),
+    CJSON_U64(0xaf8e5410, 0x288e1b6f), CJSON_U64(0x07ecf0ae, 0x5ee44dd9),
+    CJSON_U64(0xdb71e914, 0x32b1a24a), CJSON_U64(0xc9e82cd9, 0xf69d6150),
+    CJSON_U64(0x892731ac, 0x9faf056e), CJSON_U64(0xbe311c08, 0x3a225cd2),
+    CJSON_U64(0xab70fe17, 0xc79ac6ca), CJSON_U64(0x6dbd630a, 0x48aaf406),
+    CJSON_U64(0xd64d3d9d, 0xb981787d), CJSON_U64(0x092cbbcc, 0xdad5b108),
+    CJSON_U64(0x85f04682, 0x93f0eb4e), CJSON_U64(0x25bbf560, 0x08c58ea5),
+    CJSON_U64(0xa76c5823, 0x38ed2621), CJSON_U64(0xaf2af2b8, 0x0af6f24e),
+    CJSON_U64(0xd1476e2c, 0x07286faa), CJSON_U64(0x1af5af66, 0x0db4aee1),
+    CJSON_U64(0x82cca4db, 0x847945ca), CJSON_U64(0x50d98d9f, 0xc890ed4d),
+    CJSON_U64(0xa37fce12, 0x6597973c), CJSON_U64(0xe50ff107, 0xbab528a0),
+    CJSON_U64(0xcc5fc196, 0xfefd7d0c), CJSON_U64(0x1e53ed49, 0xa96272c8),
+    CJSON_U64(0xff77b1fc, 0xbebcdc4f), CJSON_U64(0x25e8e89c, 0x13bb0f7a),
+    CJSON_U64(0x9faacf3d, 0xf73609b1), CJSON_U64(0x77b19161, 0x8c54e9ac),
+    CJSON_U64(0xc795830d, 0x75038c1d), CJSON_U64(0xd59df5b9, 0xef6a2417),
+    CJSON_U64(0xf97ae3d0, 0xd2446f25), CJSON_U64(0x4b057328, 0x6b44ad1d),
+    CJSON_U64(0x9becce62, 0x836ac577), CJSON_U64(0x4ee367f9, 0x430aec32),
+    CJSON_U64(0xc2e801fb, 0x244576d5), CJSON_U64(0x229c41f7, 0x93cda73f),
+    CJSON_U64(0xf3a20279, 0xed56d48a), CJSON_U64(0x6b435275, 0x78c1110f),
+    CJSON_U64(0x9845418c, 0x345644d6), CJSON_U64(0x830a1389, 0x6b78aaa9),
+    CJSON_U64(0xbe5691ef, 0x416bd60c), CJSON_U64(0x23cc986b, 0xc656d553),
+    CJSON_U64(0xedec366b, 0x11c6cb8f), CJSON_U64(0x2cbfbe86, 0xb7ec8aa8),
+    CJSON_U64(0x94b3a202, 0xeb1c3f39), CJSON_U64(0x7bf7d714, 0x32f3d6a9),
+    CJSON_U64(0xb9e08a83, 0xa5e34f07), CJSON_U64(0xdaf5ccd9, 0x3fb0cc53),
+    CJSON_U64(0xe858ad24, 0x8f5c22c9), CJSON_U64(0xd1b3400f, 0x8f9cff68),
+    CJSON_U64(0x91376c36, 0xd99995be), CJSON_U64(0x23100809, 0xb9c21fa1),
+    CJSON_U64(0xb5854744, 0x8ffffb2d), CJSON_U64(0xabd40a0c, 0x2832a78a),
+    CJSON_U64(0xe2e69915, 0xb3fff9f9), CJSON_U64(0x16c90c8f, 0x323f516c),
+    CJSON_U64(0x8dd01fad, 0x907ffc3b), CJSON_U64(0xae3da7d9, 0x7f6792e3),
+    CJSON_U64(0xb1442798, 0xf49ffb4a), CJSON_U64(0x99cd11cf, 0xdf41779c),
+    CJSON_U64(0xdd95317f, 0x31c7fa1d), CJSON_U64(0x40405643, 0xd711d583),
+    CJSON_U64(0x8a7d3eef, 0x7f1cfc52), CJSON_U64(0x482835ea, 0x666b2572),
+    CJSON_U64(0xad1c8eab, 0x5ee43b66), CJSON_U64(0xda324365, 0x0005eecf),
+    CJSON_U64(0xd863b256, 0x369d4a40), CJSON_U64(0x90bed43e, 0x40076a82),
+    CJSON_U64(0x873e4f75, 0xe2224e68), CJSON_U64(0x5a7744a6, 0xe804a291),
+    CJSON_U64(0xa90de353, 0x5aaae202), CJSON_U64(0x711515d0, 0xa205cb36),
+    CJSON_U64(0xd3515c28, 0x31559a83), CJSON_U64(0x0d5a5b44, 0xca873e03),
+    CJSON_U64(0x8412d999, 0x1ed58091), CJSON_U64(0xe858790a, 0xfe9486c2),
+    CJSON_U64(0xa5178fff, 0x668ae0b6), CJSON_U64(0x626e974d, 0xbe39a872),
+    CJSON_U64(0xce5d73ff, 0x402d98e3), CJSON_U64(0xfb0a3d21, 0x2dc8128f),
+    CJSON_U64(0x80fa687f, 0x881c7f8e), CJSON_U64(0x7ce66634, 0xbc9d0b99),
+    CJSON_U64(0xa139029f, 0x6a239f72), CJSON_U64(0x1c1fffc1, 0xebc44e80),
+    CJSON_U64(0xc9874347, 0x44ac874e), CJSON_U64(0xa327ffb2, 0x66b56220),
+    CJSON_U64(0xfbe91419, 0x15d7a922), CJSON_U64(0x4bf1ff9f, 0x0062baa8),
+    CJSON_U64(0x9d71ac8f, 0xada6c9b5), CJSON_U64(0x6f773fc3, 0x603db4a9),
+    CJSON_U64(0xc4ce17b3, 0x99107c22), CJSON_U64(0xcb550fb4, 0x384d21d3),
+    CJSON_U64(0xf6019da0, 0x7f549b2b), CJSON_U64(0x7e2a53a1, 0x46606a48),
+    CJSON_U64(0x99c10284, 0x4f94e0fb), CJSON_U64(0x2eda7444, 0xcbfc426d),
+    CJSON_U64(0xc0314325, 0x637a1939), CJSON_U64(0xfa911155, 0xfefb5308),
+    CJSON_U64(0xf03d93ee, 0xbc589f88), CJSON_U64(0x793555ab, 0x7eba27ca),
+    CJSON_U64(0x96267c75, 0x35b763b5), CJSON_U64(0x4bc1558b, 0x2f3458de),
+    CJSON_U64(0xbbb01b92, 0x83253ca2), CJSON_U64(0x9eb1aaed, 0xfb016f16),
+    CJSON_U64(0xea9c2277, 0x23ee8bcb), CJSON_U64(0x465e15a9, 0x79c1cadc),
+    CJSON_U64(0x92a1958a, 0x7675175f), CJSON_U64(0x0bfacd89, 0xec191ec9),
+    CJSON_U64(0xb749faed, 0x14125d36), CJSON_U64(0xcef980ec, 0x671f667b),
+    CJSON_U64(0xe51c79a8, 0x5916f484), CJSON_U64(0x82b7e127, 0x80e7401a),
+    CJSON_U64(0x8f31cc09, 0x37ae58d2), CJSON_U64(0xd1b2ecb8, 0xb0908810),
+    CJSON_U64(0xb2fe3f0b, 0x8599ef07), CJSON_U64(0x861fa7e6, 0xdcb4aa15),
+    CJSON_U64(0xdfbdcece, 0x67006ac9), CJSON_U64(0x67a791e0, 0x93e1d49a),
+    CJSON_U64(0x8bd6a141, 0x006042bd), CJSON_U64(0xe0c8bb2c, 0x5c6d24e0),
+    CJSON_U64(0xaecc4991, 0x4078536d), CJSON_U64(0x58fae9f7, 0x73886e18),
+    CJSON_U64(0xda7f5bf5, 0x90966848), CJSON_U64(0xaf39a475, 0x506a899e),
+    CJSON_U64(0x888f9979, 0x7a5e012d), CJSON_U64(0x6d8406c9, 0x52429603),
+    CJSON_U64(0xaab37fd7, 0xd8f58178), CJSON_U64(0xc8e5087b, 0xa6d33b83),
+    CJSON_U64(0xd5605fcd, 0xcf32e1d6), CJSON_U64(0xfb1e4a9a, 0x90880a64),
+    CJSON_U64(0x855c3be0, 0xa17fcd26), CJSON_U64(0x5cf2eea0, 0x9a55067f),
+    CJSON_U64(0xa6b34ad8, 0xc9dfc06f), CJSON_U64(0xf42faa48, 0xc0ea481e),
+    CJSON_U64(0xd0601d8e, 0xfc57b08b), CJSON_U64(0xf13b94da, 0xf124da26),
+    CJSON_U64(0x823c1279, 0x5db6ce57), CJSON_U64(0x76c53d08, 0xd6b70858),
+    CJSON_U64(0xa2cb1717, 0xb52481ed), CJSON_U64(0x54768c4b, 0x0c64ca6e),
+    CJSON_U64(0xcb7ddcdd, 0xa26da268), CJSON_U64(0xa9942f5d, 0xcf7dfd09),
+    CJSON_U64(0xfe5d5415, 0x0b090b02), CJSON_U64(0xd3f93b35, 0x435d7c4c),
+    CJSON_U64(0x9efa548d, 0x26e5a6e1), CJSON_U64(0xc47bc501, 0x4a1a6daf),
+    CJSON_U64(0xc6b8e9b0, 0x709f109a), CJSON_U64(0x359ab641, 0x9ca1091b),
+    CJSON_U64(0xf867241c, 0x8cc6d4c0), CJSON_U64(0xc30163d2, 0x03c94b62),
+    CJSON_U64(0x9b407691, 0xd7fc44f8), CJSON_U64(0x79e0de63, 0x425dcf1d),
+    CJSON_U64(0xc2109436, 0x4dfb5636), CJSON_U64(0x985915fc, 0x12f542e4),
+    CJSON_U64(0xf294b943, 0xe17a2bc4), CJSON_U64(0x3e6f5b7b, 0x17b2939d),
+    CJSON_U64(0x979cf3ca, 0x6cec5b5a), CJSON_U64(0xa705992c, 0xeecf9c42),
+    CJSON_U64(0xbd8430bd, 0x08277231), CJSON_U64(0x50c6ff78, 0x2a838353),
+    CJSON_U64(0xece53cec, 0x4a314ebd), CJSON_U64(0xa4f8bf56, 0x35246428),
+    CJSON_U64(0x940f4613, 0xae5ed136), CJSON_U64(0x871b7795, 0xe136be99),
+    CJSON_U64(0xb9131798, 0x99f68584), CJSON_U64(0x28e2557b, 0x59846e3f),
+    CJSON_U64(0xe757dd7e, 0xc07426e5), CJSON_U64(0x331aeada, 0x2fe589cf),
+    CJSON_U64(0x9096ea6f, 0x3848984f), CJSON_U64(0x3ff0d2c8, 0x5def7621),
+    CJSON_U64(0xb4bca50b, 0x065abe63), CJSON_U64(0x0fed077a, 0x756b53a9),
+    CJSON_U64(0xe1ebce4d, 0xc7f16dfb), CJSON_U64(0xd3e84959, 0x12c62894),
+    CJSON_U64(0x8d3360f0, 0x9cf6e4bd), CJSON_U64(0x64712dd7, 0xabbbd95c),
+    CJSON_U64(0xb080392c, 0xc4349dec), CJSON_U64(0xbd8d794d, 0x96aacfb3),
+    CJSON_U64(0xdca04777, 0xf541c567), CJSON_U64(0xecf0d7a0, 0xfc5583a0),
+    CJSON_U64(0x89e42caa, 0xf9491b60), CJSON_U64(0xf41686c4, 0x9db57244),
+    CJSON_U64(0xac5d37d5, 0xb79b6239), CJSON_U64(0x311c2875, 0xc522ced5),
+    CJSON_U64(0xd77485cb, 0x25823ac7), CJSON_U64(0x7d633293, 0x366b828b),
+    CJSON_U64(0x86a8d39e, 0xf77164bc), CJSON_U64(0xae5dff9c, 0x02033197),
+    CJSON_U64(0xa8530886, 0xb54dbdeb), CJSON_U64(0xd9f57f83, 0x0283fdfc),
+    CJSON_U64(0xd267caa8, 0x62a12d66), CJSON_U64(0xd072df63, 0xc324fd7b),
+    CJSON_U64(0x8380dea9, 0x3da4bc60), CJSON_U64(0x4247cb9e, 0x59f71e6d),
+    CJSON_U64(0xa4611653, 0x8d0deb78), CJSON_U64(0x52d9be85, 0xf074e608),
+    CJSON_U64(0xcd795be8, 0x70516656), CJSON_U64(0x67902e27, 0x6c921f8b),
+    CJSON_U64(0x806bd971, 0x4632dff6), CJSON_U64(0x00ba1cd8, 0xa3db53b6),
+    CJSON_U64(0xa086cfcd, 0x97bf97f3), CJSON_U64(0x80e8a40e, 0xccd228a4),
+    CJSON_U64(0xc8a883c0, 0xfdaf7df0), CJSON_U64(0x6122cd12, 0x8006b2cd),
+    CJSON_U64(0xfad2a4b1, 0x3d1b5d6c), CJSON_U64(0x796b8057, 0x20085f81),
+    CJSON_U64(0x9cc3a6ee, 0xc6311a63), CJSON_U64(0xcbe33036, 0x74053bb0),
+    CJSON_U64(0xc3f490aa, 0x77bd60fc), CJSON_U64(0xbedbfc44, 0x11068a9c),
+    CJSON_U64(0xf4f1b4d5, 0x15acb93b), CJSON_U64(0xee92fb55, 0x15482d44),
+    CJSON_U64(0x99171105, 0x2d8bf3c5), CJSON_U64(0x751bdd15, 0x2d4d1c4a),
+    CJSON_U64(0xbf5cd546, 0x78eef0b6), CJSON_U64(0xd262d45a, 0x78a0635d),
+    CJSON_U64(0xef340a98, 0x172aace4), CJSON_U64(0x86fb8971, 0x16c87c34),
+    CJSON_U64(0x9580869f, 0x0e7aac0e), CJSON_U64(0xd45d35e6, 0xae3d4da0),
+    CJSON_U64(0xbae0a846, 0xd2195712), CJSON_U64(0x89748360, 0x59cca109),
+    CJSON_U64(0xe998d258, 0x869facd7), CJSON_U64(0x2bd1a438, 0x703fc94b),
+    CJSON_U64(0x91ff8377, 0x5423cc06), CJSON_U64(0x7b6306a3, 0x4627ddcf),
+    CJSON_U64(0xb67f6455, 0x292cbf08), CJSON_U64(0x1a3bc84c, 0x17b1d542),
+    CJSON_U64(0xe41f3d6a, 0x7377eeca), CJSON_U64(0x20caba5f, 0x1d9e4a93),
+    CJSON_U64(0x8e938662, 0x882af53e), CJSON_U64(0x547eb47b, 0x7282ee9c),
+    CJSON_U64(0xb23867fb, 0x2a35b28d), CJSON_U64(0xe99e619a, 0x4f23aa43),
+    CJSON_U64(0xdec681f9, 0xf4c31f31), CJSON_U64(0x6405fa00, 0xe2ec94d4),
+    CJSON_U64(0x8b3c113c, 0x38f9f37e), CJSON_U64(0xde83bc40, 0x8dd3dd04),
+    CJSON_U64(0xae0b158b, 0x4738705e), CJSON_U64(0x9624ab50, 0xb148d445),
+    CJSON_U64(0xd98ddaee, 0x19068c76), CJSON_U64(0x3badd624, 0xdd9b0957),
+    CJSON_U64(0x87f8a8d4, 0xcfa417c9), CJSON_U64(0xe54ca5d7, 0x0a80e5d6),
+    CJSON_U64(0xa9f6d30a, 0x038d1dbc), CJSON_U64(0x5e9fcf4c, 0xcd211f4c),
+    CJSON_U64(0xd47487cc, 0x8470652b), CJSON_U64(0x7647c320, 0x0069671f),
+    CJSON_U64(0x84c8d4df, 0xd2c63f3b), CJSON_U64(0x29ecd9f4, 0x0041e073),
+    CJSON_U64(0xa5fb0a17, 0xc777cf09), CJSON_U64(0xf4681071, 0x00525890),
+    CJSON_U64(0xcf79cc9d, 0xb955c2cc), CJSON_U64(0x7182148d, 0x4066eeb4),
+    CJSON_U64(0x81ac1fe2, 0x93d599bf), CJSON_U64(0xc6f14cd8, 0x48405530),
+    CJSON_U64(0xa21727db, 0x38cb002f), CJSON_U64(0xb8ada00e, 0x5a506a7c),
+    CJSON_U64(0xca9cf1d2, 0x06fdc03b), CJSON_U64(0xa6d90811, 0xf0e4851c),
+    CJSON_U64(0xfd442e46, 0x88bd304a), CJSON_U64(0x908f4a16, 0x6d1da663),
+    CJSON_U64(0x9e4a9cec, 0x15763e2e), CJSON_U64(0x9a598e4e, 0x043287fe),
+    CJSON_U64(0xc5dd4427, 0x1ad3cdba), CJSON_U64(0x40eff1e1, 0x853f29fd),
+    CJSON_U64(0xf7549530, 0xe188c128), CJSON_U64(0xd12bee59, 0xe68ef47c),
+    CJSON_U64(0x9a94dd3e, 0x8cf578b9), CJSON_U64(0x82bb74f8, 0x301958ce),
+    CJSON_U64(0xc13a148e, 0x3032d6e7), CJSON_U64(0xe36a5236, 0x3c1faf01),
+    CJSON_U64(0xf18899b1, 0xbc3f8ca1), CJSON_U64(0xdc44e6c3, 0xcb279ac1),
+    CJSON_U64(0x96f5600f, 0x15a7b7e5), CJSON_U64(0x29ab103a, 0x5ef8c0b9),
+    CJSON_U64(0xbcb2b812, 0xdb11a5de), CJSON_U64(0x7415d448, 0xf6b6f0e7),
+    CJSON_U64(0xebdf6617, 0x91d60f56), CJSON_U64(0x111b495b, 0x3464ad21),
+    CJSON_U64(0x936b9fce, 0xbb25c995), CJSON_U64(0xcab10dd9, 0x00beec34),
+    CJSON_U64(0xb84687c2, 0x69ef3bfb), CJSON_U64(0x3d5d514f, 0x40eea742),
+    CJSON_U64(0xe65829b3, 0x046b0afa), CJSON_U64(0x0cb4a5a3, 0x112a5112),
+    CJSON_U64(0x8ff71a0f, 0xe2c2e6dc), CJSON_U64(0x47f0e785, 0xeaba72ab),
+    CJSON_U64(0xb3f4e093, 0xdb73a093), CJSON_U64(0x59ed2167, 0x65690f56),
+    CJSON_U64(0xe0f218b8, 0xd25088b8), CJSON_U64(0x306869c1, 0x3ec3532c),
+    CJSON_U64(0x8c974f73, 0x83725573), CJSON_U64(0x1e414218, 0xc73a13fb),
+    CJSON_U64(0xafbd2350, 0x644eeacf), CJSON_U64(0xe5d1929e, 0xf90898fa),
+    CJSON_U64(0xdbac6c24, 0x7d62a583), CJSON_U64(0xdf45f746, 0xb74abf39),
+    CJSON_U64(0x894bc396, 0xce5da772), CJSON_U64(0x6b8bba8c, 0x328eb783),
+    CJSON_U64(0xab9eb47c, 0x81f5114f), CJSON_U64(0x066ea92f, 0x3f326564),
+    CJSON_U64(0xd686619b, 0xa27255a2), CJSON_U64(0xc80a537b, 0x0efefebd),
+    CJSON_U64(0x8613fd01, 0x45877585), CJSON_U64(0xbd06742c, 0xe95f5f36),
+    CJSON_U64(0xa798fc41, 0x96e952e7), CJSON_U64(0x2c481138, 0x23b73704),
+    CJSON_U64(0xd17f3b51, 0xfca3a7a0), CJSON_U64(0xf75a1586, 0x2ca504c5),
+    CJSON_U64(0x82ef8513, 0x3de648c4), CJSON_U64(0x9a984d73, 0xdbe722fb),
+    CJSON_U64(0xa3ab6658, 0x0d5fdaf5), CJSON_U64(0xc13e60d0, 0xd2e0ebba),
+    CJSON_U64(0xcc963fee, 0x10b7d1b3), CJSON_U64(0x318df905, 0x079926a8),
+    CJSON_U64(0xffbbcfe9, 0x94e5c61f), CJSON_U64(0xfdf17746, 0x497f7052),
+    CJSON_U64(0x9fd561f1, 0xfd0f9bd3), CJSON_U64(0xfeb6ea8b, 0xedefa633),
+    CJSON_U64(0xc7caba6e, 0x7c5382c8), CJSON_U64(0xfe64a52e, 0xe96b8fc0),
+    CJSON_U64(0xf9bd690a, 0x1b68637b), CJSON_U64(0x3dfdce7a, 0xa3c673b0),
+    CJSON_U64(0x9c1661a6, 0x51213e2d), CJSON_U64(0x06bea10c, 0xa65c084e),
+    CJSON_U64(0xc31bfa0f, 0xe5698db8), CJSON_U64(0x486e494f, 0xcff30a62),
+    CJSON_U64(0xf3e2f893, 0xdec3f126), CJSON_U64(0x5a89dba3, 0xc3efccfa),
+    CJSON_U64(0x986ddb5c, 0x6b3a76b7), CJSON_U64(0xf8962946, 0x5a75e01c),
+    CJSON_U64(0xbe895233, 0x86091465), CJSON_U64(0xf6bbb397, 0xf1135823),
+    CJSON_U64(0xee2ba6c0, 0x678b597f), CJSON_U64(0x746aa07d, 0xed582e2c),
+    CJSON_U64(0x94db4838, 0x40b717ef), CJSON_U64(0xa8c2a44e, 0xb4571cdc),
+    CJSON_U64(0xba121a46, 0x50e4ddeb), CJSON_U64(0x92f34d62, 0x616ce413),
+    CJSON_U64(0xe896a0d7, 0xe51e1566), CJSON_U64(0x77b020ba, 0xf9c81d17),
+    CJSON_U64(0x915e2486, 0xef32cd60), CJSON_U64(0x0ace1474, 0xdc1d122e),
+    CJSON_U64(0xb5b5ada8, 0xaaff80b8), CJSON_U64(0x0d819992, 0x132456ba),
+    CJSON_U64(0xe3231912, 0xd5bf60e6), CJSON_U64(0x10e1fff6, 0x97ed6c69),
+    CJSON_U64(0x8df5efab, 0xc5979c8f), CJSON_U64(0xca8d3ffa, 0x1ef463c1),
+    CJSON_U64(0xb1736b96, 0xb6fd83b3), CJSON_U64(0xbd308ff8, 0xa6b17cb2),
+    CJSON_U64(0xddd0467c, 0x64bce4a0), CJSON_U64(0xac7cb3f6, 0xd05ddbde),
+    CJSON_U64(0x8aa22c0d, 0xbef60ee4), CJSON_U64(0x6bcdf07a, 0x423aa96b),
+    CJSON_U64(0xad4ab711, 0x2eb3929d), CJSON_U64(0x86c16c98, 0xd2c953c6),
+    CJSON_U64(0xd89d64d5, 0x7a607744), CJSON_U64(0xe871c7bf, 0x077ba8b7),
+    CJSON_U64(0x87625f05, 0x6c7c4a8b), CJSON_U64(0x11471cd7, 0x64ad4972),
+    CJSON_U64(0xa93af6c6, 0xc79b5d2d), CJSON_U64(0xd598e40d, 0x3dd89bcf),
+    CJSON_U64(0xd389b478, 0x79823479), CJSON_U64(0x4aff1d10, 0x8d4ec2c3),
+    CJSON_U64(0x843610cb, 0x4bf160cb), CJSON_U64(0xcedf722a, 0x585139ba),
+    CJSON_U64(0xa54394fe, 0x1eedb8fe), CJSON_U64(0xc2974eb4, 0xee658828),
+    CJSON_U64(0xce947a3d, 0xa6a9273e), CJSON_U64(0x733d2262, 0x29feea32),
+    CJSON_U64(0x811ccc66, 0x8829b887), CJSON_U64(0x0806357d, 0x5a3f525f),
+    CJSON_U64(0xa163ff80, 0x2a3426a8), CJSON_U64(0xca07c2dc, 0xb0cf26f7),
+    CJSON_U64(0xc9bcff60, 0x34c13052), CJSON_U64(0xfc89b393, 0xdd02f0b5),
+    CJSON_U64(0xfc2c3f38, 0x41f17c67), CJSON_U64(0xbbac2078, 0xd443ace2),
+    CJSON_U64(0x9d9ba783, 0x2936edc0), CJSON_U64(0xd54b944b, 0x84aa4c0d),
+    CJSON_U64(0xc5029163, 0xf384a931), CJSON_U64(0x0a9e795e, 0x65d4df11),
+    CJSON_U64(0xf64335bc, 0xf065d37d), CJSON_U64(0x4d4617b5, 0xff4a16d5),
+    CJSON_U64(0x99ea0196, 0x163fa42e), CJSON_U64(0x504bced1, 0xbf8e4e45),
+    CJSON_U64(0xc06481fb, 0x9bcf8d39), CJSON_U64(0xe45ec286, 0x2f71e1d6),
+    CJSON_U64(0xf07da27a, 0x82c37088), CJSON_U64(0x5d767327, 0xbb4e5a4c),
+    CJSON_U64(0x964e858c, 0x91ba2655), CJSON_U64(0x3a6a07f8, 0xd510f86f),
+    CJSON_U64(0xbbe226ef, 0xb628afea), CJSON_U64(0x890489f7, 0x0a55368b),
+    CJSON_U64(0xeadab0ab, 0xa3b2dbe5), CJSON_U64(0x2b45ac74, 0xccea842e),
+    CJSON_U64(0x92c8ae6b, 0x464fc96f), CJSON_U64(0x3b0b8bc9, 0x0012929d),
+    CJSON_U64(0xb77ada06, 0x17e3bbcb), CJSON_U64(0x09ce6ebb, 0x40173744),
+    CJSON_U64(0xe5599087, 0x9ddcaabd), CJSON_U64(0xcc420a6a, 0x101d0515),
+    CJSON_U64(0x8f57fa54, 0xc2a9eab6), CJSON_U64(0x9fa94682, 0x4a12232d),
+    CJSON_U64(0xb32df8e9, 0xf3546564), CJSON_U64(0x47939822, 0xdc96abf9),
+    CJSON_U64(0xdff97724, 0x70297ebd), CJSON_U64(0x59787e2b, 0x93bc56f7),
+    CJSON_U64(0x8bfbea76, 0xc619ef36), CJSON_U64(0x57eb4edb, 0x3c55b65a),
+    CJSON_U64(0xaefae514, 0x77a06b03), CJSON_U64(0xede62292, 0x0b6b23f1),
+    CJSON_U64(0xdab99e59, 0x958885c4), CJSON_U64(0xe95fab36, 0x8e45eced),
+    CJSON_U64(0x88b402f7, 0xfd75539b), CJSON_U64(0x11dbcb02, 0x18ebb414),
+    CJSON_U64(0xaae103b5, 0xfcd2a881), CJSON_U64(0xd652bdc2, 0x9f26a119),
+    CJSON_U64(0xd59944a3, 0x7c0752a2), CJSON_U64(0x4be76d33, 0x46f0495f),
+    CJSON_U64(0x857fcae6, 0x2d8493a5), CJSON_U64(0x6f70a440, 0x0c562ddb),
+    CJSON_U64(0xa6dfbd9f, 0xb8e5b88e), CJSON_U64(0xcb4ccd50, 0x0f6bb952),
+    CJSON_U64(0xd097ad07, 0xa71f26b2), CJSON_U64(0x7e2000a4, 0x1346a7a7),
+    CJSON_U64(0x825ecc24, 0xc873782f), CJSON_U64(0x8ed40066, 0x8c0c28c8),
+    CJSON_U64(0xa2f67f2d, 0xfa90563b), CJSON_U64(0x72890080, 0x2f0f32fa),
+    CJSON_U64(0xcbb41ef9, 0x79346bca), CJSON_U64(0x4f2b40a0, 0x3ad2ffb9),
+    CJSON_U64(0xfea126b7, 0xd78186bc), CJSON_U64(0xe2f610c8, 0x4987bfa8),
+    CJSON_U64(0x9f24b832, 0xe6b0f436), CJSON_U64(0x0dd9ca7d, 0x2df4d7c9),
+    CJSON_U64(0xc6ede63f, 0xa05d3143), CJSON_U64(0x91503d1c, 0x79720dbb),
+    CJSON_U64(0xf8a95fcf, 0x88747d94), CJSON_U64(0x75a44c63, 0x97ce912a),
+    CJSON_U64(0x9b69dbe1, 0xb548ce7c), CJSON_U64(0xc986afbe, 0x3ee11aba),
+    CJSON_U64(0xc24452da, 0x229b021b), CJSON_U64(0xfbe85bad, 0xce996168),
+    CJSON_U64(0xf2d56790, 0xab41c2a2), CJSON_U64(0xfae27299, 0x423fb9c3),
+    CJSON_U64(0x97c560ba, 0x6b0919a5), CJSON_U64(0xdccd879f, 0xc967d41a),
+    CJSON_U64(0xbdb6b8e9, 0x05cb600f), CJSON_U64(0x5400e987, 0xbbc1c920),
+    CJSON_U64(0xed246723, 0x473e3813), CJSON_U64(0x290123e9, 0xaab23b68),
+    CJSON_U64(0x9436c076, 0x0c86e30b), CJSON_U64(0xf9a0b672, 0x0aaf6521),
+    CJSON_U64(0xb9447093, 0x8fa89bce), CJSON_U64(0xf808e40e, 0x8d5b3e69),
+    CJSON_U64(0xe7958cb8, 0x7392c2c2), CJSON_U64(0xb60b1d12, 0x30b20e04),
+    CJSON_U64(0x90bd77f3, 0x483bb9b9), CJSON_U64(0xb1c6f22b, 0x5e6f48c2),
+    CJSON_U64(0xb4ecd5f0, 0x1a4aa828), CJSON_U64(0x1e38aeb6, 0x360b1af3),
+    CJSON_U64(0xe2280b6c, 0x20dd5232), CJSON_U64(0x25c6da63, 0xc38de1b0),
+    CJSON_U64(0x8d590723, 0x948a535f), CJSON_U64(0x579c487e, 0x5a38ad0e),
+    CJSON_U64(0xb0af48ec, 0x79ace837), CJSON_U64(0x2d835a9d, 0xf0c6d851),
+    CJSON_U64(0xdcdb1b27, 0x98182244), CJSON_U64(0xf8e43145, 0x6cf88e65),
+    CJSON_U64(0x8a08f0f8, 0xbf0f156b), CJSON_U64(0x1b8e9ecb, 0x641b58ff),
+    CJSON_U64(0xac8b2d36, 0xeed2dac5), CJSON_U64(0xe272467e, 0x3d222f3f),
+    CJSON_U64(0xd7adf884, 0xaa879177), CJSON_U64(0x5b0ed81d, 0xcc6abb0f),
+    CJSON_U64(0x86ccbb52, 0xea94baea), CJSON_U64(0x98e94712, 0x9fc2b4e9),
+    CJSON_U64(0xa87fea27, 0xa539e9a5), CJSON_U64(0x3f2398d7, 0x47b36224),
+    CJSON_U64(0xd29fe4b1, 0x8e88640e), CJSON_U64(0x8eec7f0d, 0x19a03aad),
+    CJSON_U64(0x83a3eeee, 0xf9153e89), CJSON_U64(0x1953cf68, 0x300424ac),
+    CJSON_U64(0xa48ceaaa, 0xb75a8e2b), CJSON_U64(0x5fa8c342, 0x3c052dd7),
+    CJSON_U64(0xcdb02555, 0x653131b6), CJSON_U64(0x3792f412, 0xcb06794d),
+    CJSON_U64(0x808e1755, 0x5f3ebf11), CJSON_U64(0xe2bbd88b, 0xbee40bd0),
+    CJSON_U64(0xa0b19d2a, 0xb70e6ed6), CJSON_U64(0x5b6aceae, 0xae9d0ec4),
+    CJSON_U64(0xc8de0475, 0x64d20a8b), CJSON_U64(0xf245825a, 0x5a445275),
+    CJSON_U64(0xfb158592, 0xbe068d2e), CJSON_U64(0xeed6e2f0, 0xf0d56712),
+    CJSON_U64(0x9ced737b, 0xb6c4183d), CJSON_U64(0x55464dd6, 0x9685606b),
+    CJSON_U64(0xc428d05a, 0xa4751e4c), CJSON_U64(0xaa97e14c, 0x3c26b886),
+    CJSON_U64(0xf5330471, 0x4d9265df), CJSON_U64(0xd53dd99f, 0x4b3066a8),
+    CJSON_U64(0x993fe2c6, 0xd07b7fab), CJSON_U64(0xe546a803, 0x8efe4029),
+    CJSON_U64(0xbf8fdb78, 0x849a5f96), CJSON_U64(0xde985204, 0x72bdd033),
+    CJSON_U64(0xef73d256, 0xa5c0f77c), CJSON_U64(0x963e6685, 0x8f6d4440),
+    CJSON_U64(0x95a86376, 0x27989aad), CJSON_U64(0xdde70013, 0x79a44aa8),
+    CJSON_U64(0xbb127c53, 0xb17ec159), CJSON_U64(0x5560c018, 0x580d5d52),
+    CJSON_U64(0xe9d71b68, 0x9dde71af), CJSON_U64(0xaab8f01e, 0x6e10b4a6),
+    CJSON_U64(0x92267121, 0x62ab070d), CJSON_U64(0xcab39613, 0x04ca70e8),
+    CJSON_U64(0xb6b00d69, 0xbb55c8d1), CJSON_U64(0x3d607b97, 0xc5fd0d22),
+    CJSON_U64(0xe45c10c4, 0x2a2b3b05), CJSON_U64(0x8cb89a7d, 0xb77c506a),
+    CJSON_U64(0x8eb98a7a, 0x9a5b04e3), CJSON_U64(0x77f3608e, 0x92adb242),
+    CJSON_U64(0xb267ed19, 0x40f1c61c), CJSON_U64(0x55f038b2, 0x37591ed3),
+    CJSON_U64(0xdf01e85f, 0x912e37a3), CJSON_U64(0x6b6c46de, 0xc52f6688),
+    CJSON_U64(0x8b61313b, 0xbabce2c6), CJSON_U64(0x2323ac4b, 0x3b3da015),
+    CJSON_U64(0xae397d8a, 0xa96c1b77), CJSON_U64(0xabec975e, 0x0a0d081a),
+    CJSON_U64(0xd9c7dced, 0x53c72255), CJSON_U64(0x96e7bd35, 0x8c904a21),
+    CJSON_U64(0x881cea14, 0x545c7575), CJSON_U64(0x7e50d641, 0x77da2e54),
+    CJSON_U64(0xaa242499, 0x697392d2), CJSON_U64(0xdde50bd1, 0xd5d0b9e9),
+    CJSON_U64(0xd4ad2dbf, 0xc3d07787), CJSON_U64(0x955e4ec6, 0x4b44e864),
+    CJSON_U64(0x84ec3c97, 0xda624ab4), CJSON_U64(0xbd5af13b, 0xef0b113e),
+    CJSON_U64(0xa6274bbd, 0xd0fadd61), CJSON_U64(0xecb1ad8a, 0xeacdd58e),
+    CJSON_U64(0xcfb11ead, 0x453994ba), CJSON_U64(0x67de18ed, 0xa5814af2),
+    CJSON_U64(0x81ceb32c, 0x4b43fcf4), CJSON_U64(0x80eacf94, 0x8770ced7),
+    CJSON_U64(0xa2425ff7, 0x5e14fc31), CJSON_U64(0xa1258379, 0xa94d028d),
+    CJSON_U64(0xcad2f7f5, 0x359a3b3e), CJSON_U64(0x096ee458, 0x13a04330),
+    CJSON_U64(0xfd87b5f2, 0x8300ca0d), CJSON_U64(0x8bca9d6e, 0x188853fc),
+    CJSON_U64(0x9e74d1b7, 0x91e07e48), CJSON_U64(0x775ea264, 0xcf55347e),
+    CJSON_U64(0xc6120625, 0x76589dda), CJSON_U64(0x95364afe, 0x032a819e),
+    CJSON_U64(0xf79687ae, 0xd3eec551), CJSON_U64(0x3a83ddbd, 0x83f52205),
+    CJSON_U64(0x9abe14cd, 0x44753b52), CJSON_U64(0xc4926a96, 0x72793543),
+    CJSON_U64(0xc16d9a00, 0x95928a27), CJSON_U64(0x75b7053c, 0x0f178294),
+    CJSON_U64(0xf1c90080, 0xbaf72cb1), CJSON_U64(0x5324c68b, 0x12dd6339),
+    CJSON_U64(0x971da050, 0x74da7bee), CJSON_U64(0xd3f6fc16, 0xebca5e04),
+    CJSON_U64(0xbce50864, 0x92111aea), CJSON_U64(0x88f4bb1c, 0xa6bcf585),
+    CJSON_U64(0xec1e4a7d, 0xb69561a5), CJSON_U64(0x2b31e9e3, 0xd06c32e6),
+    CJSON_U64(0x9392ee8e, 0x921d5d07), CJSON_U64(0x3aff322e, 0x62439fd0),
+    CJSON_U64(0xb877aa32, 0x36a4b449), CJSON_U64(0x09befeb9, 0xfad487c3),
+    CJSON_U64(0xe69594be, 0xc44de15b), CJSON_U64(0x4c2ebe68, 0x7989a9b4),
+    CJSON_U64(0x901d7cf7, 0x3ab0acd9), CJSON_U64(0x0f9d3701, 0x4bf60a11),
+    CJSON_U64(0xb424dc35, 0x095cd80f), CJSON_U64(0x538484c1, 0x9ef38c95),
+    CJSON_U64(0xe12e1342, 0x4bb40e13), CJSON_U64(0x2865a5f2, 0x06b06fba),
+    CJSON_U64(0x8cbccc09, 0x6f5088cb), CJSON_U64(0xf93f87b7, 0x442e45d4),
+    CJSON_U64(0xafebff0b, 0xcb24aafe), CJSON_U64(0xf78f69a5, 0x1539d749),
+    CJSON_U64(0xdbe6fece, 0xbdedd5be), CJSON_U64(0xb573440e, 0x5a884d1c),
+    CJSON_U64(0x89705f41, 0x36b4a597), CJSON_U64(0x31680a88, 0xf8953031),
+    CJSON_U64(0xabcc7711, 0x8461cefc), CJSON_U64(0xfdc20d2b, 0x36ba7c3e),
+    CJSON_U64(0xd6bf94d5, 0xe57a42bc), CJSON_U64(0x3d329076, 0x04691b4d),
+    CJSON_U64(0x8637bd05, 0xaf6c69b5), CJSON_U64(0xa63f9a49, 0xc2c1b110),
+    CJSON_U64(0xa7c5ac47, 0x1b478423), CJSON_U64(0x0fcf80dc, 0x33721d54),
+    CJSON_U64(0xd1b71758, 0xe219652b), CJSON_U64(0xd3c36113, 0x404ea4a9),
+    CJSON_U64(0x83126e97, 0x8d4fdf3b), CJSON_U64(0x645a1cac, 0x083126ea),
+    CJSON_U64(0xa3d70a3d, 0x70a3d70a), CJSON_U64(0x3d70a3d7, 0x0a3d70a4),
+    CJSON_U64(0xcccccccc, 0xcccccccc), CJSON_U64(0xcccccccc, 0xcccccccd),
+    CJSON_U64(0x80000000, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xa0000000, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xc8000000, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xfa000000, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0x9c400000, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xc3500000, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xf4240000, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0x98968000, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xbebc2000, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xee6b2800, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0x9502f900, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xba43b740, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xe8d4a510, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0x9184e72a, 0x00000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xb5e620f4, 0x80000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xe35fa931, 0xa0000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0x8e1bc9bf, 0x04000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xb1a2bc2e, 0xc5000000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xde0b6b3a, 0x76400000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0x8ac72304, 0x89e80000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xad78ebc5, 0xac620000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xd8d726b7, 0x177a8000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0x87867832, 0x6eac9000), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xa968163f, 0x0a57b400), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xd3c21bce, 0xcceda100), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0x84595161, 0x401484a0), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xa56fa5b9, 0x9019a5c8), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0xcecb8f27, 0xf4200f3a), CJSON_U64(0x00000000, 0x00000000),
+    CJSON_U64(0x813f3978, 0xf8940984), CJSON_U64(0x40000000, 0x00000000),
+    CJSON_U64(0xa18f07d7, 0x36b90be5), CJSON_U64(0x50000000, 0x00000000),
+    CJSON_U64(0xc9f2c9cd, 0x04674ede), CJSON_U64(0xa4000000, 0x00000000),
+    CJSON_U64(0xfc6f7c40, 0x45812296), CJSON_U64(0x4d000000, 0x00000000),
+    CJSON_U64(0x9dc5ada8, 0x2b70b59d), CJSON_U64(0xf0200000, 0x00000000),
+    CJSON_U64(0xc5371912, 0x364ce305), CJSON_U64(0x6c280000, 0x00000000),
+    CJSON_U64(0xf684df56, 0xc3e01bc6), CJSON_U64(0xc7320000, 0x00000000),
+    CJSON_U64(0x9a130b96, 0x3a6c115c), CJSON_U64(0x3c7f4000, 0x00000000),
+    CJSON_U64(0xc097ce7b, 0xc90715b3), CJSON_U64(0x4b9f1000, 0x00000000),
+    CJSON_U64(0xf0bdc21a, 0xbb48db20), CJSON_U64(0x1e86d400, 0x00000000),
+    CJSON_U64(0x96769950, 0xb50d88f4), CJSON_U64(0x13144480, 0x00000000),
+    CJSON_U64(0xbc143fa4, 0xe250eb31), CJSON_U64(0x17d955a0, 0x00000000),
+    CJSON_U64(0xeb194f8e, 0x1ae525fd), CJSON_U64(0x5dcfab08, 0x00000000),
+    CJSON_U64(0x92efd1b8, 0xd0cf37be), CJSON_U64(0x5aa1cae5, 0x00000000),
+    CJSON_U64(0xb7abc627, 0x050305ad), CJSON_U64(0xf14a3d9e, 0x40000000),
+    CJSON_U64(0xe596b7b0, 0xc643c719), CJSON_U64(0x6d9ccd05, 0xd0000000),
+    CJSON_U64(0x8f7e32ce, 0x7bea5c6f), CJSON_U64(0xe4820023, 0xa2000000),
+    CJSON_U64(0xb35dbf82, 0x1ae4f38b), CJSON_U64(0xdda2802c, 0x8a800000),
+    CJSON_U64(0xe0352f62, 0xa19e306e), CJSON_U64(0xd50b2037, 0xad200000),
+    CJSON_U64(0x8c213d9d, 0xa502de45), CJSON_U64(0x4526f422, 0xcc340000),
+    CJSON_U64(0xaf298d05, 0x0e4395d6), CJSON_U64(0x9670b12b, 0x7f410000),
+    CJSON_U64(0xdaf3f046, 0x51d47b4c), CJSON_U64(0x3c0cdd76, 0x5f114000),
+    CJSON_U64(0x88d8762b, 0xf324cd0f), CJSON_U64(0xa5880a69, 0xfb6ac800),
+    CJSON_U64(0xab0e93b6, 0xefee0053), CJSON_U64(0x8eea0d04, 0x7a457a00),
+    CJSON_U64(0xd5d238a4, 0xabe98068), CJSON_U64(0x72a49045, 0x98d6d880),
+    CJSON_U64(0x85a36366, 0xeb71f041), CJSON_U64(0x47a6da2b, 0x7f864750),
+    CJSON_U64(0xa70c3c40, 0xa64e6c51), CJSON_U64(0x999090b6, 0x5f67d924),
+    CJSON_U64(0xd0cf4b50, 0xcfe20765), CJSON_U64(0xfff4b4e3, 0xf741cf6d),
+    CJSON_U64(0x82818f12, 0x81ed449f), CJSON_U64(0xbff8f10e, 0x7a8921a4),
+    CJSON_U64(0xa321f2d7, 0x226895c7), CJSON_U64(0xaff72d52, 0x192b6a0d),
+    CJSON_U64(0xcbea6f8c, 0xeb02bb39), CJSON_U64(0x9bf4f8a6, 0x9f764490),
+    CJSON_U64(0xfee50b70, 0x25c36a08), CJSON_U64(0x02f236d0, 0x4753d5b4),
+    CJSON_U64(0x9f4f2726, 0x179a2245), CJSON_U64(0x01d76242, 0x2c946590),
+    CJSON_U64(0xc722f0ef, 0x9d80aad6), CJSON_U64(0x424d3ad2, 0xb7b97ef5),
+    CJSON_U64(0xf8ebad2b, 0x84e0d58b), CJSON_U64(0xd2e08987, 0x65a7deb2),
+    CJSON_U64(0x9b934c3b, 0x330c8577), CJSON_U64(0x63cc55f4, 0x9f88eb2f),
+    CJSON_U64(0xc2781f49, 0xffcfa6d5), CJSON_U64(0x3cbf6b71, 0xc76b25fb),
+    CJSON_U64(0xf316271c, 0x7fc3908a), CJSON_U64(0x8bef464e, 0x3945ef7a),
+    CJSON_U64(0x97edd871, 0xcfda3a56), CJSON_U64(0x97758bf0, 0xe3cbb5ac),
+    CJSON_U64(0xbde94e8e, 0x43d0c8ec), CJSON_U64(0x3d52eeed, 0x1cbea317),
+    CJSON_U64(0xed63a231, 0xd4c4fb27), CJSON_U64(0x4ca7aaa8, 0x63ee4bdd),
+    CJSON_U64(0x945e455f, 0x24fb1cf8), CJSON_U64(0x8fe8caa9, 0x3e74ef6a),
+    CJSON_U64(0xb975d6b6, 0xee39e436), CJSON_U64(0xb3e2fd53, 0x8e122b44),
+    CJSON_U64(0xe7d34c64, 0xa9c85d44), CJSON_U64(0x60dbbca8, 0x7196b616),
+    CJSON_U64(0x90e40fbe, 0xea1d3a4a), CJSON_U64(0xbc8955e9, 0x46fe31cd),
+    CJSON_U64(0xb51d13ae, 0xa4a488dd), CJSON_U64(0x6babab63, 0x98bdbe41),
+    CJSON_U64(0xe264589a, 0x4dcdab14), CJSON_U64(0xc696963c, 0x7eed2dd1),
+    CJSON_U64(0x8d7eb760, 0x70a08aec), CJSON_U64(0xfc1e1de5, 0xcf543ca2),
+    CJSON_U64(0xb0de6538, 0x8cc8ada8), CJSON_U64(0x3b25a55f, 0x43294bcb),
+    CJSON_U64(0xdd15fe86, 0xaffad912), CJSON_U64(0x49ef0eb7, 0x13f39ebe),
+    CJSON_U64(0x8a2dbf14, 0x2dfcc7ab), CJSON_U64(0x6e356932, 0x6c784337),
+    CJSON_U64(0xacb92ed9, 0x397bf996), CJSON_U64(0x49c2c37f, 0x07965404),
+    CJSON_U64(0xd7e77a8f, 0x87daf7fb), CJSON_U64(0xdc33745e, 0xc97be906),
+    CJSON_U64(0x86f0ac99, 0xb4e8dafd), CJSON_U64(0x69a028bb, 0x3ded71a3),
+    CJSON_U64(0xa8acd7c0, 0x222311bc), CJSON_U64(0xc40832ea, 0x0d68ce0c),
+    CJSON_U64(0xd2d80db0, 0x2aabd62b), CJSON_U64(0xf50a3fa4, 0x90c30190),
+    CJSON_U64(0x83c7088e, 0x1aab65db), CJSON_U64(0x792667c6, 0xda79e0fa),
+    CJSON_U64(0xa4b8cab1, 0xa1563f52), CJSON_U64(0x577001b8, 0x91185938),
+    CJSON_U64(0xcde6fd5e, 0x09abcf26), CJSON_U64(0xed4c0226, 0xb55e6f86),
+    CJSON_U64(0x80b05e5a, 0xc60b6178), CJSON_U64(0x544f8158, 0x315b05b4),
+    CJSON_U64(0xa0dc75f1, 0x778e39d6), CJSON_U64(0x696361ae, 0x3db1c721),
+    CJSON_U64(0xc913936d, 0xd571c84c), CJSON_U64(0x03bc3a19, 0xcd1e38e9),
+    CJSON_U64(0xfb587849, 0x4ace3a5f), CJSON_U64(0x04ab48a0, 0x4065c723),
+    CJSON_U64(0x9d174b2d, 0xcec0e47b), CJSON_U64(0x62eb0d64, 0x283f9c76),
+    CJSON_U64(0xc45d1df9, 0x42711d9a), CJSON_U64(0x3ba5d0bd, 0x324f8394),
+    CJSON_U64(0xf5746577, 0x930d6500), CJSON_U64(0xca8f44ec, 0x7ee36479),
+    CJSON_U64(0x9968bf6a, 0xbbe85f20), CJSON_U64(0x7e998b13, 0xcf4e1ecb),
+    CJSON_U64(0xbfc2ef45, 0x6ae276e8), CJSON_U64(0x9e3fedd8, 0xc321a67e),
+    CJSON_U64(0xefb3ab16, 0xc59b14a2), CJSON_U64(0xc5cfe94e, 0xf3ea101e),
+    CJSON_U64(0x95d04aee, 0x3b80ece5), CJSON_U64(0xbba1f1d1, 0x58724a12),
+    CJSON_U64(0xbb445da9, 0xca61281f), CJSON_U64(0x2a8a6e45, 0xae8edc97),
+    CJSON_U64(0xea157514, 0x3cf97226), CJSON_U64(0xf52d09d7, 0x1a3293bd),
+    CJSON_U64(0x924d692c, 0xa61be758), CJSON_U64(0x593c2626, 0x705f9c56),
+    CJSON_U64(0xb6e0c377, 0xcfa2e12e), CJSON_U64(0x6f8b2fb0, 0x0c77836c),
+    CJSON_U64(0xe498f455, 0xc38b997a), CJSON_U64(0x0b6dfb9c, 0x0f956447),
+    CJSON_U64(0x8edf98b5, 0x9a373fec), CJSON_U64(0x4724bd41, 0x89bd5eac),
+    CJSON_U64(0xb2977ee3, 0x00c50fe7), CJSON_U64(0x58edec91, 0xec2cb657),
+    CJSON_U64(0xdf3d5e9b, 0xc0f653e1), CJSON_U64(0x2f2967b6, 0x6737e3ed),
+    CJSON_U64(0x8b865b21, 0x5899f46c), CJSON_U64(0xbd79e0d2, 0x0082ee74),
+    CJSON_U64(0xae67f1e9, 0xaec07187), CJSON_U64(0xecd85906, 0x80a3aa11),
+    CJSON_U64(0xda01ee64, 0x1a708de9), CJSON_U64(0xe80e6f48, 0x20cc9495),
+    CJSON_U64(0x884134fe, 0x908658b2), CJSON_U64(0x3109058d, 0x147fdcdd),
+    CJSON_U64(0xaa51823e, 0x34a7eede), CJSON_U64(0xbd4b46f0, 0x599fd415),
+    CJSON_U64(0xd4e5e2cd, 0xc1d1ea96), CJSON_U64(0x6c9e18ac, 0x7007c91a),
+    CJSON_U64(0x850fadc0, 0x9923329e), CJSON_U64(0x03e2cf6b, 0xc604ddb0),
+    CJSON_U64(0xa6539930, 0xbf6bff45), CJSON_U64(0x84db8346, 0xb786151c),
+    CJSON_U64(0xcfe87f7c, 0xef46ff16), CJSON_U64(0xe6126418, 0x65679a63),
+    CJSON_U64(0x81f14fae, 0x158c5f6e), CJSON_U64(0x4fcb7e8f, 0x3f60c07e),
+    CJSON_U64(0xa26da399, 0x9aef7749), CJSON_U64(0xe3be5e33, 0x0f38f09d),
+    CJSON_U64(0xcb090c80, 0x01ab551c), CJSON_U64(0x5cadf5bf, 0xd3072cc5),
+    CJSON_U64(0xfdcb4fa0, 0x02162a63), CJSON_U64(0x73d9732f, 0xc7c8f7f6),
+    CJSON_U64(0x9e9f11c4, 0x014dda7e), CJSON_U64(0x2867e7fd, 0xdcdd9afa),
+    CJSON_U64(0xc646d635, 0x01a1511d), CJSON_U64(0xb281e1fd, 0x541501b8),
+    CJSON_U64(0xf7d88bc2, 0x4209a565), CJSON_U64(0x1f225a7c, 0xa91a4226),
+    CJSON_U64(0x9ae75759, 0x6946075f), CJSON_U64(0x3375788d, 0xe9b06958),
+    CJSON_U64(0xc1a12d2f, 0xc3978937), CJSON_U64(0x0052d6b1, 0x641c83ae),
+    CJSON_U64(0xf209787b, 0xb47d6b84), CJSON_U64(0xc0678c5d, 0xbd23a49a),
+    CJSON_U64(0x9745eb4d, 0x50ce6332), CJSON_U64(0xf840b7ba, 0x963646e0),
+    CJSON_U64(0xbd176620, 0xa501fbff), CJSON_U64(0xb650e5a9, 0x3bc3d898),
+    CJSON_U64(0xec5d3fa8, 0xce427aff), CJSON_U64(0xa3e51f13, 0x8ab4cebe),
+    CJSON_U64(0x93ba47c9, 0x80e98cdf), CJSON_U64(0xc66f336c, 0x36b10137),
+    CJSON_U64(0xb8a8d9bb, 0xe123f017), CJSON_U64(0xb80b0047, 0x445d4184),
+    CJSON_U64(0xe6d3102a, 0xd96cec1d), CJSON_U64(0xa60dc059, 0x157491e5),
+    CJSON_U64(0x9043ea1a, 0xc7e41392), CJSON_U64(0x87c89837, 0xad68db2f),
+    CJSON_U64(0xb454e4a1, 0x79dd1877), CJSON_U64(0x29babe45, 0x98c311fb),
+    CJSON_U64(0xe16a1dc9, 0xd8545e94), CJSON_U64(0xf4296dd6, 0xfef3d67a),
+    CJSON_U64(0x8ce2529e, 0x2734bb1d), CJSON_U64(0x1899e4a6, 0x5f58660c),
+    CJSON_U64(0xb01ae745, 0xb101e9e4), CJSON_U64(0x5ec05dcf, 0xf72e7f8f),
+    CJSON_U64(0xdc21a117, 0x1d42645d), CJSON_U64(0x76707543, 0xf4fa1f73),
+    CJSON_U64(0x899504ae, 0x72497eba), CJSON_U64(0x6a06494a, 0x791c53a8),
+    CJSON_U64(0xabfa45da, 0x0edbde69), CJSON_U64(0x0487db9d, 0x17636892),
+    CJSON_U64(0xd6f8d750, 0x9292d603), CJSON_U64(0x45a9d284, 0x5d3c42b6),
+    CJSON_U64(0x865b8692, 0x5b9bc5c2), CJSON_U64(0x0b8a2392, 0xba45a9b2),
+    CJSON_U64(0xa7f26836, 0xf282b732), CJSON_U64(0x8e6cac77, 0x68d7141e),
+    CJSON_U64(0xd1ef0244, 0xaf2364ff), CJSON_U64(0x3207d795, 0x430cd926),
+    CJSON_U64(0x8335616a, 0xed761f1f), CJSON_U64(0x7f44e6bd, 0x49e807b8),
+    CJSON_U64(0xa402b9c5, 0xa8d3a6e7), CJSON_U64(0x5f16206c, 0x9c6209a6),
+    CJSON_U64(0xcd036837, 0x130890a1), CJSON_U64(0x36dba887, 0xc37a8c0f),
+    CJSON_U64(0x80222122, 0x6be55a64), CJSON_U64(0xc2494954, 0xda2c9789),
+    CJSON_U64(0xa02aa96b, 0x06deb0fd), CJSON_U64(0xf2db9baa, 0x10b7bd6c),
+    CJSON_U64(0xc83553c5, 0xc8965d3d), CJSON_U64(0x6f928294, 0x94e5acc7),
+    CJSON_U64(0xfa42a8b7, 0x3abbf48c), CJSON_U64(0xcb772339, 0xba1f17f9),
+    CJSON_U64(0x9c69a972, 0x84b578d7), CJSON_U64(0xff2a7604, 0x14536efb),
+    CJSON_U64(0xc38413cf, 0x25e2d70d), CJSON_U64(0xfef51385, 0x19684aba),
+    CJSON_U64(0xf46518c2, 0xef5b8cd1), CJSON_U64(0x7eb25866, 0x5fc25d69),
+    CJSON_U64(0x98bf2f79, 0xd5993802), CJSON_U64(0xef2f773f, 0xfbd97a61),
+    CJSON_U64(0xbeeefb58, 0x4aff8603), CJSON_U64(0xaafb550f, 0xfacfd8fa),
+    CJSON_U64(0xeeaaba2e, 0x5dbf6784), CJSON_U64(0x95ba2a53, 0xf983cf38),
+    CJSON_U64(0x952ab45c, 0xfa97a0b2), CJSON_U64(0xdd945a74, 0x7bf26183),
+    CJSON_U64(0xba756174, 0x393d88df), CJSON_U64(0x94f97111, 0x9aeef9e4),
+    CJSON_U64(0xe912b9d1, 0x478ceb17), CJSON_U64(0x7a37cd56, 0x01aab85d),
+    CJSON_U64(0x91abb422, 0xccb812ee), CJSON_U64(0xac62e055, 0xc10ab33a),
+    CJSON_U64(0xb616a12b, 0x7fe617aa), CJSON_U64(0x577b986b, 0x314d6009),
+    CJSON_U64(0xe39c4976, 0x5fdf9d94), CJSON_U64(0xed5a7e85, 0xfda0b80b),
+    CJSON_U64(0x8e41ade9, 0xfbebc27d), CJSON_U64(0x14588f13, 0xbe847307),
+    CJSON_U64(0xb1d21964, 0x7ae6b31c), CJSON_U64(0x596eb2d8, 0xae258fc8),
+    CJSON_U64(0xde469fbd, 0x99a05fe3), CJSON_U64(0x6fca5f8e, 0xd9aef3bb),
+    CJSON_U64(0x8aec23d6, 0x80043bee), CJSON_U64(0x25de7bb9, 0x480d5854),
+    CJSON_U64(0xada72ccc, 0x20054ae9), CJSON_U64(0xaf561aa7, 0x9a10ae6a),
+    CJSON_U64(0xd910f7ff, 0x28069da4), CJSON_U64(0x1b2ba151, 0x8094da04),
+    CJSON_U64(0x87aa9aff, 0x79042286), CJSON_U64(0x90fb44d2, 0xf05d0842),
+    CJSON_U64(0xa99541bf, 0x57452b28), CJSON_U64(0x353a1607, 0xac744a53),
+    CJSON_U64(0xd3fa922f, 0x2d1675f2), CJSON_U64(0x42889b89, 0x97915ce8),
+    CJSON_U64(0x847c9b5d, 0x7c2e09b7), CJSON_U64(0x69956135, 0xfebada11),
+    CJSON_U64(0xa59bc234, 0xdb398c25), CJSON_U64(0x43fab983, 0x7e699095),
+    CJSON_U64(0xcf02b2c2, 0x1207ef2e), CJSON_U64(0x94f967e4, 0x5e03f4bb),
+    CJSON_U64(0x8161afb9, 0x4b44f57d), CJSON_U64(0x1d1be0ee, 0xbac278f5),
+    CJSON_U64(0xa1ba1ba7, 0x9e1632dc), CJSON_U64(0x6462d92a, 0x69731732),
+    CJSON_U64(0xca28a291, 0x859bbf93), CJSON_U64(0x7d7b8f75, 0x03cfdcfe),
+    CJSON_U64(0xfcb2cb35, 0xe702af78), CJSON_U64(0x5cda7352, 0x44c3d43e),
+    CJSON_U64(0x9defbf01, 0xb061adab), CJSON_U64(0x3a088813, 0x6afa64a7),
+    CJSON_U64(0xc56baec2, 0x1c7a1916), CJSON_U64(0x088aaa18, 0x45b8fdd0),
+    CJSON_U64(0xf6c69a72, 0xa3989f5b), CJSON_U64(0x8aad549e, 0x57273d45),
+    CJSON_U64(0x9a3c2087, 0xa63f6399), CJSON_U64(0x36ac54e2, 0xf678864b),
+    CJSON_U64(0xc0cb28a9, 0x8fcf3c7f), CJSON_U64(0x84576a1b, 0xb416a7dd),
+    CJSON_U64(0xf0fdf2d3, 0xf3c30b9f), CJSON_U64(0x656d44a2, 0xa11c51d5),
+    CJSON_U64(0x969eb7c4, 0x7859e743), CJSON_U64(0x9f644ae5, 0xa4b1b325),
+    CJSON_U64(0xbc4665b5, 0x96706114), CJSON_U64(0x873d5d9f, 0x0dde1fee),
+    CJSON_U64(0xeb57ff22, 0xfc0c7959), CJSON_U64(0xa90cb506, 0xd155a7ea),
+    CJSON_U64(0x9316ff75, 0xdd87cbd8), CJSON_U64(0x09a7f124, 0x42d588f2),
+    CJSON_U64(0xb7dcbf53, 0x54e9bece), CJSON_U64(0x0c11ed6d, 0x538aeb2f),
+    CJSON_U64(0xe5d3ef28, 0x2a242e81), CJSON_U64(0x8f1668c8, 0xa86da5fa),
+    CJSON_U64(0x8fa47579, 0x1a569d10), CJSON_U64(0xf96e017d, 0x694487bc),
+    CJSON_U64(0xb38d92d7, 0x60ec4455), CJSON_U64(0x37c981dc, 0xc395a9ac),
+    CJSON_U64(0xe070f78d, 0x3927556a), CJSON_U64(0x85bbe253, 0xf47b1417),
+    CJSON_U64(0x8c469ab8, 0x43b89562), CJSON_U64(0x93956d74, 0x78ccec8e),
+    CJSON_U64(0xaf584166, 0x54a6babb), CJSON_U64(0x387ac8d1, 0x970027b2),
+    CJSON_U64(0xdb2e51bf, 0xe9d0696a), CJSON_U64(0x06997b05, 0xfcc0319e),
+    CJSON_U64(0x88fcf317, 0xf22241e2), CJSON_U64(0x441fece3, 0xbdf81f03),
+    CJSON_U64(0xab3c2fdd, 0xeeaad25a), CJSON_U64(0xd527e81c, 0xad7626c3),
+    CJSON_U64(0xd60b3bd5, 0x6a5586f1), CJSON_U64(0x8a71e223, 0xd8d3b074),
+    CJSON_U64(0x85c70565, 0x62757456), CJSON_U64(0xf6872d56, 0x67844e49),
+    CJSON_U64(0xa738c6be, 0xbb12d16c), CJSON_U64(0xb428f8ac, 0x016561db),
+    CJSON_U64(0xd106f86e, 0x69d785c7), CJSON_U64(0xe13336d7, 0x01beba52),
+    CJSON_U64(0x82a45b45, 0x0226b39c), CJSON_U64(0xecc00246, 0x61173473),
+    CJSON_U64(0xa34d7216, 0x42b06084), CJSON_U64(0x27f002d7, 0xf95d0190),
+    CJSON_U64(0xcc20ce9b, 0xd35c78a5), CJSON_U64(0x31ec038d, 0xf7b441f4),
+    CJSON_U64(0xff290242, 0xc83396ce), CJSON_U64(0x7e670471, 0x75a15271),
+    CJSON_U64(0x9f79a169, 0xbd203e41), CJSON_U64(0x0f0062c6, 0xe984d386),
+    CJSON_U64(0xc75809c4, 0x2c684dd1), CJSON_U64(0x52c07b78, 0xa3e60868),
+    CJSON_U64(0xf92e0c35, 0x37826145), CJSON_U64(0xa7709a56, 0xccdf8a82),
+    CJSON_U64(0x9bbcc7a1, 0x42b17ccb), CJSON_U64(0x88a66076, 0x400bb691),
+    CJSON_U64(0xc2abf989, 0x935ddbfe), CJSON_U64(0x6acff893, 0xd00ea435),
+    CJSON_U64(0xf356f7eb, 0xf83552fe), CJSON_U64(0x0583f6b8, 0xc4124d43),
+    CJSON_U64(0x98165af3, 0x7b2153de), CJSON_U64(0xc3727a33, 0x7a8b704a),
+    CJSON_U64(0xbe1bf1b0, 0x59e9a8d6), CJSON_U64(0x744f18c0, 0x592e4c5c),
+    CJSON_U64(0xeda2ee1c, 0x7064130c), CJSON_U64(0x1162def0, 0x6f79df73),
+    CJSON_U64(0x9485d4d1, 0xc63e8be7), CJSON_U64(0x8addcb56, 0x45ac2ba8),
+    CJSON_U64(0xb9a74a06, 0x37ce2ee1), CJSON_U64(0x6d953e2b, 0xd7173692),
+    CJSON_U64(0xe8111c87, 0xc5c1ba99), CJSON_U64(0xc8fa8db6, 0xccdd0437),
+    CJSON_U64(0x910ab1d4, 0xdb9914a0), CJSON_U64(0x1d9c9892, 0x400a22a2),
+    CJSON_U64(0xb54d5e4a, 0x127f59c8), CJSON_U64(0x2503beb6, 0xd00cab4b),
+    CJSON_U64(0xe2a0b5dc, 0x971f303a), CJSON_U64(0x2e44ae64, 0x840fd61d),
+    CJSON_U64(0x8da471a9, 0xde737e24), CJSON_U64(0x5ceaecfe, 0xd289e5d2),
+    CJSON_U64(0xb10d8e14, 0x56105dad), CJSON_U64(0x7425a83e, 0x872c5f47),
+    CJSON_U64(0xdd50f199, 0x6b947518), CJSON_U64(0xd12f124e, 0x28f77719),
+    CJSON_U64(0x8a5296ff, 0xe33cc92f), CJSON_U64(0x82bd6b70, 0xd99aaa6f),
+    CJSON_U64(0xace73cbf, 0xdc0bfb7b), CJSON_U64(0x636cc64d, 0x1001550b),
+    CJSON_U64(0xd8210bef, 0xd30efa5a), CJSON_U64(0x3c47f7e0, 0x5401aa4e),
+    CJSON_U64(0x8714a775, 0xe3e95c78), CJSON_U64(0x65acfaec, 0x34810a71),
+    CJSON_U64(0xa8d9d153, 0x5ce3b396), CJSON_U64(0x7f1839a7, 0x41a14d0d),
+    CJSON_U64(0xd31045a8, 0x341ca07c), CJSON_U64(0x1ede4811, 0x1209a050),
+    CJSON_U64(0x83ea2b89, 0x2091e44d), CJSON_U64(0x934aed0a, 0xab460432),
+    CJSON_U64(0xa4e4b66b, 0x68b65d60), CJSON_U64(0xf81da84d, 0x5617853f),
+    CJSON_U64(0xce1de406, 0x42e3f4b9), CJSON_U64(0x36251260, 0xab9d668e),
+    CJSON_U64(0x80d2ae83, 0xe9ce78f3), CJSON_U64(0xc1d72b7c, 0x6b426019),
+    CJSON_U64(0xa1075a24, 0xe4421730), CJSON_U64(0xb24cf65b, 0x8612f81f),
+    CJSON_U64(0xc94930ae, 0x1d529cfc), CJSON_U64(0xdee033f2, 0x6797b627),
+    CJSON_U64(0xfb9b7cd9, 0xa4a7443c), CJSON_U64(0x169840ef, 0x017da3b1),
+    CJSON_U64(0x9d412e08, 0x06e88aa5), CJSON_U64(0x8e1f2895, 0x60ee864e),
+    CJSON_U64(0xc491798a, 0x08a2ad4e), CJSON_U64(0xf1a6f2ba, 0xb92a27e2),
+    CJSON_U64(0xf5b5d7ec, 0x8acb58a2), CJSON_U64(0xae10af69, 0x6774b1db),
+    CJSON_U64(0x9991a6f3, 0xd6bf1765), CJSON_U64(0xacca6da1, 0xe0a8ef29),
+    CJSON_U64(0xbff610b0, 0xcc6edd3f), CJSON_U64(0x17fd090a, 0x58d32af3),
+    CJSON_U64(0xeff394dc, 0xff8a948e), CJSON_U64(0xddfc4b4c, 0xef07f5b0),
+    CJSON_U64(0x95f83d0a, 0x1fb69cd9), CJSON_U64(0x4abdaf10, 0x1564f98e),
+    CJSON_U64(0xbb764c4c, 0xa7a4440f), CJSON_U64(0x9d6d1ad4, 0x1abe37f1),
+    CJSON_U64(0xea53df5f, 0xd18d5513), CJSON_U64(0x84c86189, 0x216dc5ed),
+    CJSON_U64(0x92746b9b, 0xe2f8552c), CJSON_U64(0x32fd3cf5, 0xb4e49bb4),
+    CJSON_U64(0xb7118682, 0xdbb66a77), CJSON_U64(0x3fbc8c33, 0x221dc2a1),
+    CJSON_U64(0xe4d5e823, 0x92a40515), CJSON_U64(0x0fabaf3f, 0xeaa5334a),
+    CJSON_U64(0x8f05b116, 0x3ba6832d), CJSON_U64(0x29cb4d87, 0xf2a7400e),
+    CJSON_U64(0xb2c71d5b, 0xca9023f8), CJSON_U64(0x743e20e9, 0xef511012),
+    CJSON_U64(0xdf78e4b2, 0xbd342cf6), CJSON_U64(0x914da924, 0x6b255416),
+    CJSON_U64(0x8bab8eef, 0xb6409c1a), CJSON_U64(0x1ad089b6, 0xc2f7548e),
+    CJSON_U64(0xae9672ab, 0xa3d0c320), CJSON_U64(0xa184ac24, 0x73b529b1),
+    CJSON_U64(0xda3c0f56, 0x8cc4f3e8), CJSON_U64(0xc9e5d72d, 0x90a2741e),
+    CJSON_U64(0x88658996, 0x17fb1871), CJSON_U64(0x7e2fa67c, 0x7a658892),
+    CJSON_U64(0xaa7eebfb, 0x9df9de8d), CJSON_U64(0xddbb901b, 0x98feeab7),
+    CJSON_U64(0xd51ea6fa, 0x85785631), CJSON_U64(0x552a7422, 0x7f3ea565),
+    CJSON_U64(0x8533285c, 0x936b35de), CJSON_U64(0xd53a8895, 0x8f87275f),
+    CJSON_U64(0xa67ff273, 0xb8460356), CJSON_U64(0x8a892aba, 0xf368f137),
+    CJSON_U64(0xd01fef10, 0xa657842c), CJSON_U64(0x2d2b7569, 0xb0432d85),
+    CJSON_U64(0x8213f56a, 0x67f6b29b), CJSON_U64(0x9c3b2962, 0x0e29fc73),
+    CJSON_U64(0xa298f2c5, 0x01f45f42), CJSON_U64(0x8349f3ba, 0x91b47b8f),
+    CJSON_U64(0xcb3f2f76, 0x42717713), CJSON_U64(0x241c70a9, 0x36219a73),
+    CJSON_U64(0xfe0efb53, 0xd30dd4d7), CJSON_U64(0xed238cd3, 0x83aa0110),
+    CJSON_U64(0x9ec95d14, 0x63e8a506), CJSON_U64(0xf4363804, 0x324a40aa),
+    CJSON_U64(0xc67bb459, 0x7ce2ce48), CJSON_U64(0xb143c605, 0x3edcd0d5),
+    CJSON_U64(0xf81aa16f, 0xdc1b81da), CJSON_U64(0xdd94b786, 0x8e94050a),
+    CJSON_U64(0x9b10a4e5, 0xe9913128), CJSON_U64(0xca7cf2b4, 0x191c8326),
+    CJSON_U64(0xc1d4ce1f, 0x63f57d72), CJSON_U64(0xfd1c2f61, 0x1f63a3f0),
+    CJSON_U64(0xf24a01a7, 0x3cf2dccf), CJSON_U64(0xbc633b39, 0x673c8cec),
+    CJSON_U64(0x976e4108, 0x8617ca01), CJSON_U64(0xd5be0503, 0xe085d813),
+    CJSON_U64(0xbd49d14a, 0xa79dbc82), CJSON_U64(0x4b2d8644, 0xd8a74e18),
+    CJSON_U64(0xec9c459d, 0x51852ba2), CJSON_U64(0xddf8e7d6, 0x0ed1219e),
+    CJSON_U64(0x93e1ab82, 0x52f33b45), CJSON_U64(0xcabb90e5, 0xc942b503),
+    CJSON_U64(0xb8da1662, 0xe7b00a17), CJSON_U64(0x3d6a751f, 0x3b936243),
+    CJSON_U64(0xe7109bfb, 0xa19c0c9d), CJSON_U64(0x0cc51267, 0x0a783ad4),
+    CJSON_U64(0x906a617d, 0x450187e2), CJSON_U64(0x27fb2b80, 0x668b24c5),
+    CJSON_U64(0xb484f9dc, 0x9641e9da), CJSON_U64(0xb1f9f660, 0x802dedf6),
+    CJSON_U64(0xe1a63853, 0xbbd26451), CJSON_U64(0x5e7873f8, 0xa0396973),
+    CJSON_U64(0x8d07e334, 0x55637eb2), CJSON_U64(0xdb0b487b, 0x6423e1e8),
+    CJSON_U64(0xb049dc01, 0x6abc5e5f), CJSON_U64(0x91ce1a9a, 0x3d2cda62),
+    CJSON_U64(0xdc5c5301, 0xc56b75f7), CJSON_U64(0x7641a140, 0xcc7810fb),
+    CJSON_U64(0x89b9b3e1, 0x1b6329ba), CJSON_U64(0xa9e904c8, 0x7fcb0a9d),
+    CJSON_U64(0xac2820d9, 0x623bf429), CJSON_U64(0x546345fa, 0x9fbdcd44),
+    CJSON_U64(0xd732290f, 0xbacaf133), CJSON_U64(0xa97c1779, 0x47ad4095),
+    CJSON_U64(0x867f59a9, 0xd4bed6c0), CJSON_U64(0x49ed8eab, 0xcccc485d),
+    CJSON_U64(0xa81f3014, 0x49ee8c70), CJSON_U64(0x5c68f256, 0xbfff5a74),
+    CJSON_U64(0xd226fc19, 0x5c6a2f8c), CJSON_U64(0x73832eec, 0x6fff3111),
+    CJSON_U64(0x83585d8f, 0xd9c25db7), CJSON_U64(0xc831fd53, 0xc5ff7eab),
+    CJSON_U64(0xa42e74f3, 0xd032f525), CJSON_U64(0xba3e7ca8, 0xb77f5e55),
+    CJSON_U64(0xcd3a1230, 0xc43fb26f), CJSON_U64(0x28ce1bd2, 0xe55f35eb),
+    CJSON_U64(0x80444b5e, 0x7aa7cf85), CJSON_U64(0x7980d163, 0xcf5b81b3),
+    CJSON_U64(0xa0555e36, 0x1951c366), CJSON_U64(0xd7e105bc, 0xc332621f),
+    CJSON_U64(0xc86ab5c3, 0x9fa63440), CJSON_U64(0x8dd9472b, 0xf3fefaa7),
+    CJSON_U64(0xfa856334, 0x878fc150), CJSON_U64(0xb14f98f6, 0xf0feb951),
+    CJSON_U64(0x9c935e00, 0xd4b9d8d2), CJSON_U64(0x6ed1bf9a, 0x569f33d3),
+    CJSON_U64(0xc3b83581, 0x09e84f07), CJSON_U64(0x0a862f80, 0xec4700c8),
+    CJSON_U64(0xf4a642e1, 0x4c6262c8), CJSON_U64(0xcd27bb61, 0x2758c0fa),
+    CJSON_U64(0x98e7e9cc, 0xcfbd7dbd), CJSON_U64(0x8038d51c, 0xb897789c),
+    CJSON_U64(0xbf21e440, 0x03acdd2c), CJSON_U64(0xe0470a63, 0xe6bd56c3),
+    CJSON_U64(0xeeea5d50, 0x04981478), CJSON_U64(0x1858ccfc, 0xe06cac74),
+    CJSON_U64(0x95527a52, 0x02df0ccb), CJSON_U64(0x0f37801e, 0x0c43ebc8),
+    CJSON_U64(0xbaa718e6, 0x8396cffd), CJSON_U64(0xd3056025, 0x8f54e6ba),
+    CJSON_U64(0xe950df20, 0x247c83fd), CJSON_U64(0x47c6b82e, 0xf32a2069),
+    CJSON_U64(0x91d28b74, 0x16cdd27e), CJSON_U64(0x4cdc331d, 0x57fa5441),
+    CJSON_U64(0xb6472e51, 0x1c81471d), CJSON_U64(0xe0133fe4, 0xadf8e952),
+    CJSON_U64(0xe3d8f9e5, 0x63a198e5), CJSON_U64(0x58180fdd, 0xd97723a6),
+    CJSON_U64(0x8e679c2f, 0x5e44ff8f), CJSON_U64(0x570f09ea, 0xa7ea7648)
+
+};
+
+#ifdef CJSON_EXACT_DOUBLE_ARITHMETIC
+/* powers of ten that are exactly representable as a double */
+static const double exact_powers_of_ten[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#endif
+
+/* high and low 64 bits of a * b */
+static void multiply_64(cjson_uint64 a, cjson_uint64 b, cjson_uint64 *high, cjson_uint64 *low)
+{
+#if defined(__GNUC__) && defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (cjson_uint64)(product >> 64);
+    *low = (cjson_uint64)product;
+#else
+    cjson_uint64 a_low = a & 0xFFFFFFFFU;
+    cjson_uint64 a_high = a >> 32;
+    cjson_uint64 b_low = b & 0xFFFFFFFFU;
+    cjson_uint64 b_high = b >> 32;
+    cjson_uint64 low_low = a_low * b_low;
+    cjson_uint64 high_low = a_high * b_low;
+    cjson_uint64 low_high = a_low * b_high;
+    cjson_uint64 middle = high_low + (low_low >> 32) + (low_high & 0xFFFFFFFFU);
+    *high = (a_high * b_high) + (middle >> 32) + (low_high >> 32);
+    *low = (middle << 32) | (low_low & 0xFFFFFFFFU);
+#endif
+}
+
+static int leading_zeros_64(cjson_uint64 x)
+{
+#if defined(__GNUC__)
+    return __builtin_clzll(x);
+#else
+    int count = 0;
+    while (!(x & CJSON_U64(0x80000000, 0)))
+    {
+        x <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/* The double nearest to mantissa * 10^exponent as IEEE 754 bits without the sign,
+ * with mantissa != 0 (Eisel-Lemire, as in Lemire's fast_float with the
+ * Mushtak-Lemire proof that no second check is needed). */
+static cjson_uint64 eisel_lemire(cjson_uint64 mantissa, long exponent)
+{
+    cjson_uint64 high = 0;
+    cjson_uint64 low = 0;
+    cjson_uint64 result = 0;
+    size_t index = 0;
+    int shift = 0;
+    int upper_bit = 0;
+    int leading_zeros = 0;
+    long binary_exponent = 0;
+
+    if (exponent < POWER_OF_FIVE_MIN)
+    {
+        return 0;
+    }
+    if (exponent > POWER_OF_FIVE_MAX)
+    {
+        return CJSON_U64(0x7FF00000, 0); /* infinity */
+    }
+
+    leading_zeros = leading_zeros_64(mantissa);
+    mantissa <<= leading_zeros;
+
+    /* 55 bits are enough unless the product is close to a carry into them */
+    index = 2 * (size_t)(exponent - POWER_OF_FIVE_MIN);
+    multiply_64(mantissa, power_of_five_128[index], &high, &low);
+    if ((high & CJSON_U64(0, 0x1FF)) == CJSON_U64(0, 0x1FF))
+    {
+        cjson_uint64 second_high = 0;
+        cjson_uint64 second_low = 0;
+        multiply_64(mantissa, power_of_five_128[index + 1], &second_high, &second_low);
+        low += second_high;
+        if (second_high > low)
+        {
+            high++;
+        }
+    }
+
+    upper_bit = (int)(high >> 63);
+    shift = upper_bit + 64 - 52 - 3;
+    result = high >> shift;
+    /* floor(log2(10^exponent)) + 63, then bias the exponent */
+    binary_exponent = ((((152170L + 65536L) * exponent) >> 16) + 63) + upper_bit - leading_zeros + 1023;
+
+    if (binary_exponent <= 0)
+    {
+        /* subnormal */
+        if ((-binary_exponent + 1) >= 64)
+        {
+            return 0;
+        }
+        result >>= -binary_exponent + 1;
+        result += result & 1;
+        result >>= 1;
+        /* rounding up may have produced the smallest normal number */
+        return result;
+    }
+
+    /* exactly halfway between two doubles: round to even */
+    if ((low <= 1) && (exponent >= -4) && (exponent <= 23) && ((result & 3) == 1) && ((result << shift) == high))
+    {
+        result &= ~(cjson_uint64)1;
+    }
+
+    result += result & 1;
+    result >>= 1;
+    if (result >= CJSON_U64(0x00200000, 0))
+    {
+        result = CJSON_U64(0x00100000, 0);
+        binary_exponent++;
+    }
+    result &= ~CJSON_U64(0x00100000, 0);
+
+    if (binary_exponent >= 0x7FF)
+    {
+        return CJSON_U64(0x7FF00000, 0); /* infinity */
+    }
+
+    return result | ((cjson_uint64)binary_exponent << 52);
+}
+
+/* mantissa * 10^exponent as a double if that can be done without strtod */
+static cJSON_bool decimal_to_double(double *number, cjson_uint64 mantissa, long exponent, cJSON_bool truncated)
+{
+    cjson_uint64 bits = 0;
+
+    if (mantissa == 0)
+    {
+        *number = 0.0;
+        return true;
+    }
+
+    if (!truncated && (mantissa <= CJSON_U64(0x00200000, 0)))
+    {
+        /* integers and short decimals: one correctly rounded operation */
+        if (exponent == 0)
+        {
+            *number = (double)mantissa;
+            return true;
+        }
+#ifdef CJSON_EXACT_DOUBLE_ARITHMETIC
+        if ((exponent >= -22) && (exponent < 0))
+        {
+            *number = (double)mantissa / exact_powers_of_ten[-exponent];
+            return true;
+        }
+        if ((exponent > 0) && (exponent <= 22))
+        {
+            *number = (double)mantissa * exact_powers_of_ten[exponent];
+            return true;
+        }
+#endif
+    }
+
+    bits = eisel_lemire(mantissa, exponent);
+    /* digits were dropped: the true value lies between mantissa and mantissa + 1 */
+    if (truncated && (bits != eisel_lemire(mantissa + 1, exponent)))
+    {
+        return false;
+    }
+
+    memcpy(number, &bits, sizeof(*number));
+    return true;
+}
+#else
+#define decimal_to_double(number, mantissa, exponent, truncated) false
+#endif /* CJSON_FAST_NUMBERS */
+
+/* Convert the length bytes of number text at start with strtod, returns how many
+ * bytes it consumed or 0 on failure. */
+static size_t strtod_number(double *number, const unsigned char *start, size_t length, const internal_hooks * const hooks)
 {
-    double number = 0;
     unsigned char *after_end = NULL;
     unsigned char *number_c_string;
     unsigned char decimal_point = get_decimal_point();
     size_t i = 0;
-    size_t number_string_length = 0;
-    cJSON_bool has_decimal_point = false;
+
+    /* copy the number into a temporary buffer and replace '.' with the decimal point
+     * of the current locale (for strtod)
+     * This also takes care of '\0' not necessarily being available for marking the end of the input */
+    number_c_string = (unsigned char *) hooks_allocate(hooks, length + 1);
+    if (number_c_string == NULL)
+    {
+        return 0; /* allocation failure */
+    }
+
+    memcpy(number_c_string, start, length);
+    number_c_string[length] = '\0';
+
+    for (i = 0; i < length; i++)
+    {
+        if (number_c_string[i] == '.')
+        {
+            number_c_string[i] = decimal_point;
+        }
+    }
+
+    *number = strtod((const char*)number_c_string, (char**)&after_end);
+    /* free the temporary buffer */
+    hooks_deallocate(hooks, number_c_string);
+
+    return (size_t)(after_end - number_c_string);
+}
+
+/* Parse the input text to generate a number, and populate the result into item. */
+static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+{
+    double number = 0;
+    const unsigned char *start = NULL;
+    const unsigned char *pointer = NULL;
+    const unsigned char *end = NULL;
+    const unsigned char *exponent_start = NULL;
+    size_t digits = 0;
+    size_t length = 0;
+    cjson_uint64 mantissa = 0;
+    size_t significant_digits = 0;
+    long exponent = 0;
+    long explicit_exponent = 0;
+    cJSON_bool negative = false;
+    cJSON_bool exponent_negative = false;
+    cJSON_bool exponent_overflow = false;
+    cJSON_bool truncated = false;
 
     if ((input_buffer == NULL) || (input_buffer->content == NULL))
     {
         return false;
     }
 
-    /* copy the number into a temporary buffer and replace '.' with the decimal point
-     * of the current locale (for strtod)
-     * This also takes care of '\0' not necessarily being available for marking the end of the input */
-    for (i = 0; can_access_at_index(input_buffer, i); i++)
-    {
-        switch (buffer_at_offset(input_buffer)[i])
-        {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '+':
-            case '-':
-            case 'e':
-            case 'E':
-                number_string_length++;
-                break;
+    /* Scan the number with the grammar strtod accepts for the characters cJSON
+     * allows in numbers: [+-] digits [. digits] [(e|E) [+-] digits], with digits on at
+     * least one side of the '.', and the exponent only taken if it has digits. */
+    start = buffer_at_offset(input_buffer);
+    pointer = start;
+    end = input_buffer->content + input_buffer->length;
 
-            case '.':
-                number_string_length++;
-                has_decimal_point = true;
-                break;
+    if ((pointer < end) && ((*pointer == '-') || (*pointer == '+')))
+    {
+        negative = (*pointer == '-');
+        pointer++;
+    }
 
-            default:
-                goto loop_end;
+    for (; (pointer < end) && (*pointer >= '0') && (*pointer <= '9'); pointer++)
+    {
+        digits++;
+        if (significant_digits < 19)
+        {
+            mantissa = (mantissa * 10) + (cjson_uint64)(*pointer - '0');
+            significant_digits += (mantissa != 0);
+        }
+        else
+        {
+            exponent++;
+            truncated |= (*pointer != '0');
         }
     }
-loop_end:
-    /* malloc for temporary buffer, add 1 for '\0' */
-    number_c_string = (unsigned char *) input_buffer->hooks.allocate(number_string_length + 1);
-    if (number_c_string == NULL)
+
+    if ((pointer < end) && (*pointer == '.'))
     {
-        return false; /* allocation failure */
+        pointer++;
+        for (; (pointer < end) && (*pointer >= '0') && (*pointer <= '9'); pointer++)
+        {
+            digits++;
+            if (significant_digits < 19)
+            {
+                mantissa = (mantissa * 10) + (cjson_uint64)(*pointer - '0');
+                significant_digits += (mantissa != 0);
+                exponent--;
+            }
+            else
+            {
+                truncated |= (*pointer != '0');
+            }
+        }
     }
 
-    memcpy(number_c_string, buffer_at_offset(input_buffer), number_string_length);
-    number_c_string[number_string_length] = '\0';
+    if (digits == 0)
+    {
+        return false; /* parse_error */
+    }
 
-    if (has_decimal_point)
+    if ((pointer < end) && ((*pointer == 'e') || (*pointer == 'E')))
     {
-        for (i = 0; i < number_string_length; i++)
+        exponent_start = pointer;
+        pointer++;
+        if ((pointer < end) && ((*pointer == '-') || (*pointer == '+')))
+        {
+            exponent_negative = (*pointer == '-');
+            pointer++;
+        }
+        if ((pointer < end) && (*pointer >= '0') && (*pointer <= '9'))
         {
-            if (number_c_string[i] == '.')
+            for (; (pointer < end) && (*pointer >= '0') && (*pointer <= '9'); pointer++)
             {
-                /* replace '.' with the decimal point of the current locale (for strtod) */
-                number_c_string[i] = decimal_point;
+                if (explicit_exponent < 100000000L)
+                {
+                    explicit_exponent = (explicit_exponent * 10) + (*pointer - '0');
+                }
+                else
+                {
+                    exponent_overflow = true;
+                }
             }
         }
+        else
+        {
+            /* no exponent digits, the number ends before the 'e' */
+            pointer = exponent_start;
+        }
     }
 
-    number = strtod((const char*)number_c_string, (char**)&after_end);
-    if (number_c_string == after_end)
+    length = (size_t)(pointer - start);
+
+    exponent += exponent_negative ? -explicit_exponent : explicit_exponent;
+    if (!exponent_overflow && decimal_to_double(&number, mantissa, exponent, truncated))
     {
-        /* free the temporary buffer */
-        input_buffer->hooks.deallocate(number_c_string);
-        return false; /* parse_error */
+        if (negative)
+        {
+            number = -number;
+        }
+    }
+    else
+    {
+        length = strtod_number(&number, start, length, &input_buffer->hooks);
+        if (length == 0)
+        {
+            return false;
+        }
     }
 
     item->valuedouble = number;
@@ -401,9 +1428,7 @@ loop_end:
 
     item->type = cJSON_Number;
 
-    input_buffer->offset += (size_t)(after_end - number_c_string);
-    /* free the temporary buffer */
-    input_buffer->hooks.deallocate(number_c_string);
+    input_buffer->offset += length;
     return true;
 }
 
@@ -479,6 +1504,7 @@ typedef struct
     cJSON_bool noalloc;
     cJSON_bool format; /* is this print a formatted print */
     internal_hooks hooks;
+    cJSON_Sink *sink; /* caller-owned buffer that grows through sink->grow */
 } printbuffer;
 
 /* realloc printbuffer if necessary to have at least "needed" bytes more */
@@ -532,6 +1558,20 @@ static unsigned char* ensure(printbuffer * const p, size_t needed)
         newsize = needed * 2;
     }
 
+    if (p->sink != NULL)
+    {
+        /* the sink owns the memory, let it move the buffer */
+        p->sink->length = p->offset;
+        if ((p->sink->grow == NULL) || !p->sink->grow(p->sink, newsize) || (p->sink->buffer == NULL) || (p->sink->size < needed))
+        {
+            return NULL;
+        }
+        p->buffer = p->sink->buffer;
+        p->length = p->sink->size;
+
+        return p->buffer + p->offset;
+    }
+
     if (p->hooks.reallocate != NULL)
     {
         /* reallocate with realloc if available */
@@ -587,60 +1627,410 @@ static cJSON_bool compare_double(double a, double b)
     return (fabs(a - b) <= maxVal * DBL_EPSILON);
 }
 
-/* Render the number nicely from the given item into a string. */
-static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+#ifdef CJSON_FAST_NUMBERS
+/* Shortest double printing with Grisu2 (Loitsch, "Printing Floating-Point Numbers
+ * Quickly and Accurately with Integers"), as used by RapidJSON: the digits always
+ * parse back to the same double and are the shortest such digits in all but a
+ * tiny fraction of cases, where one more digit is printed. */
+typedef struct
 {
-    unsigned char *output_pointer = NULL;
-    double d = item->valuedouble;
-    int length = 0;
-    size_t i = 0;
-    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
-    unsigned char decimal_point = get_decimal_point();
-    double test = 0.0;
+    cjson_uint64 f;
+    int e;
+} diy_fp;
 
-    if (output_buffer == NULL)
+/* 10^k for k = -348, -340, ..., 340 as normalized 64 bit significand and binary exponent */
+static const diy_fp cached_powers[] =
+{
+    { CJSON_U64(0xfa8fd5a0, 0x081c0288), -1220 }, { CJSON_U64(0xbaaee17f, 0xa23ebf76), -1193 },
+    { CJSON_U64(0x8b16fb20, 0x3055ac76), -1166 }, { CJSON_U64(0xcf42894a, 0x5dce35ea), -1140 },
+    { CJSON_U64(0x9a6bb0aa, 0x55653b2d), -1113 }, { CJSON_U64(0xe61acf03, 0x3d1a45df), -1087 },
+    { CJSON_U64(0xab70fe17, 0xc79ac6ca), -1060 }, { CJSON_U64(0xff77b1fc, 0xbebcdc4f), -1034 },
+    { CJSON_U64(0xbe5691ef, 0x416bd60c), -1007 }, { CJSON_U64(0x8dd01fad, 0x907ffc3c), -980 },
+    { CJSON_U64(0xd3515c28, 0x31559a83), -954 }, { CJSON_U64(0x9d71ac8f, 0xada6c9b5), -927 },
+    { CJSON_U64(0xea9c2277, 0x23ee8bcb), -901 }, { CJSON_U64(0xaecc4991, 0x4078536d), -874 },
+    { CJSON_U64(0x823c1279, 0x5db6ce57), -847 }, { CJSON_U64(0xc2109436, 0x4dfb5637), -821 },
+    { CJSON_U64(0x9096ea6f, 0x3848984f), -794 }, { CJSON_U64(0xd77485cb, 0x25823ac7), -768 },
+    { CJSON_U64(0xa086cfcd, 0x97bf97f4), -741 }, { CJSON_U64(0xef340a98, 0x172aace5), -715 },
+    { CJSON_U64(0xb23867fb, 0x2a35b28e), -688 }, { CJSON_U64(0x84c8d4df, 0xd2c63f3b), -661 },
+    { CJSON_U64(0xc5dd4427, 0x1ad3cdba), -635 }, { CJSON_U64(0x936b9fce, 0xbb25c996), -608 },
+    { CJSON_U64(0xdbac6c24, 0x7d62a584), -582 }, { CJSON_U64(0xa3ab6658, 0x0d5fdaf6), -555 },
+    { CJSON_U64(0xf3e2f893, 0xdec3f126), -529 }, { CJSON_U64(0xb5b5ada8, 0xaaff80b8), -502 },
+    { CJSON_U64(0x87625f05, 0x6c7c4a8b), -475 }, { CJSON_U64(0xc9bcff60, 0x34c13053), -449 },
+    { CJSON_U64(0x964e858c, 0x91ba2655), -422 }, { CJSON_U64(0xdff97724, 0x70297ebd), -396 },
+    { CJSON_U64(0xa6dfbd9f, 0xb8e5b88f), -369 }, { CJSON_U64(0xf8a95fcf, 0x88747d94), -343 },
+    { CJSON_U64(0xb9447093, 0x8fa89bcf), -316 }, { CJSON_U64(0x8a08f0f8, 0xbf0f156b), -289 },
+    { CJSON_U64(0xcdb02555, 0x653131b6), -263 }, { CJSON_U64(0x993fe2c6, 0xd07b7fac), -236 },
+    { CJSON_U64(0xe45c10c4, 0x2a2b3b06), -210 }, { CJSON_U64(0xaa242499, 0x697392d3), -183 },
+    { CJSON_U64(0xfd87b5f2, 0x8300ca0e), -157 }, { CJSON_U64(0xbce50864, 0x92111aeb), -130 },
+    { CJSON_U64(0x8cbccc09, 0x6f5088cc), -103 }, { CJSON_U64(0xd1b71758, 0xe219652c), -77 },
+    { CJSON_U64(0x9c400000, 0x00000000), -50 }, { CJSON_U64(0xe8d4a510, 0x00000000), -24 },
+    { CJSON_U64(0xad78ebc5, 0xac620000), 3 }, { CJSON_U64(0x813f3978, 0xf8940984), 30 },
+    { CJSON_U64(0xc097ce7b, 0xc90715b3), 56 }, { CJSON_U64(0x8f7e32ce, 0x7bea5c70), 83 },
+    { CJSON_U64(0xd5d238a4, 0xabe98068), 109 }, { CJSON_U64(0x9f4f2726, 0x179a2245), 136 },
+    { CJSON_U64(0xed63a231, 0xd4c4fb27), 162 }, { CJSON_U64(0xb0de6538, 0x8cc8ada8), 189 },
+    { CJSON_U64(0x83c7088e, 0x1aab65db), 216 }, { CJSON_U64(0xc45d1df9, 0x42711d9a), 242 },
+    { CJSON_U64(0x924d692c, 0xa61be758), 269 }, { CJSON_U64(0xda01ee64, 0x1a708dea), 295 },
+    { CJSON_U64(0xa26da399, 0x9aef774a), 322 }, { CJSON_U64(0xf209787b, 0xb47d6b85), 348 },
+    { CJSON_U64(0xb454e4a1, 0x79dd1877), 375 }, { CJSON_U64(0x865b8692, 0x5b9bc5c2), 402 },
+    { CJSON_U64(0xc83553c5, 0xc8965d3d), 428 }, { CJSON_U64(0x952ab45c, 0xfa97a0b3), 455 },
+    { CJSON_U64(0xde469fbd, 0x99a05fe3), 481 }, { CJSON_U64(0xa59bc234, 0xdb398c25), 508 },
+    { CJSON_U64(0xf6c69a72, 0xa3989f5c), 534 }, { CJSON_U64(0xb7dcbf53, 0x54e9bece), 561 },
+    { CJSON_U64(0x88fcf317, 0xf22241e2), 588 }, { CJSON_U64(0xcc20ce9b, 0xd35c78a5), 614 },
+    { CJSON_U64(0x98165af3, 0x7b2153df), 641 }, { CJSON_U64(0xe2a0b5dc, 0x971f303a), 667 },
+    { CJSON_U64(0xa8d9d153, 0x5ce3b396), 694 }, { CJSON_U64(0xfb9b7cd9, 0xa4a7443c), 720 },
+    { CJSON_U64(0xbb764c4c, 0xa7a44410), 747 }, { CJSON_U64(0x8bab8eef, 0xb6409c1a), 774 },
+    { CJSON_U64(0xd01fef10, 0xa657842c), 800 }, { CJSON_U64(0x9b10a4e5, 0xe9913129), 827 },
+    { CJSON_U64(0xe7109bfb, 0xa19c0c9d), 853 }, { CJSON_U64(0xac2820d9, 0x623bf429), 880 },
+    { CJSON_U64(0x80444b5e, 0x7aa7cf85), 907 }, { CJSON_U64(0xbf21e440, 0x03acdd2d), 933 },
+    { CJSON_U64(0x8e679c2f, 0x5e44ff8f), 960 }, { CJSON_U64(0xd433179d, 0x9c8cb841), 986 },
+    { CJSON_U64(0x9e19db92, 0xb4e31ba9), 1013 }, { CJSON_U64(0xeb96bf6e, 0xbadf77d9), 1039 },
+    { CJSON_U64(0xaf87023b, 0x9bf0ee6b), 1066 }
+};
+
+static diy_fp diy_fp_multiply(diy_fp a, diy_fp b)
+{
+    diy_fp product;
+    cjson_uint64 low = 0;
+
+    multiply_64(a.f, b.f, &product.f, &low);
+    /* round to nearest */
+    product.f += low >> 63;
+    product.e = a.e + b.e + 64;
+
+    return product;
+}
+
+static diy_fp diy_fp_normalize(diy_fp x)
+{
+    int shift = leading_zeros_64(x.f);
+    x.f <<= shift;
+    x.e -= shift;
+
+    return x;
+}
+
+static cjson_uint64 power_of_ten_64(int exponent)
+{
+    cjson_uint64 power = 1;
+    while (exponent-- > 0)
     {
-        return false;
+        power *= 10;
     }
 
-    /* This checks for NaN and Infinity */
-    if (isnan(d) || isinf(d))
+    return power;
+}
+
+/* move the last digit down while that brings the digits closer to the exact value
+ * and stays within the rounding interval */
+static void grisu_round(unsigned char *digits, int length, cjson_uint64 delta, cjson_uint64 rest, cjson_uint64 ten_kappa, cjson_uint64 distance)
+{
+    while ((rest < distance) && ((delta - rest) >= ten_kappa)
+            && (((rest + ten_kappa) < distance) || ((distance - rest) > (rest + ten_kappa - distance))))
     {
-        length = sprintf((char*)number_buffer, "null");
+        digits[length - 1]--;
+        rest += ten_kappa;
     }
-    else if(d == (double)item->valueint)
+}
+
+/* Write the shortest digits of a finite, positive double, returns their count and
+ * sets *exponent so that the value is digits * 10^exponent. */
+static int grisu2(double number, unsigned char *digits, int *exponent)
+{
+    static const unsigned int powers_of_ten_32[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+    cjson_uint64 bits = 0;
+    diy_fp value;
+    diy_fp plus;
+    diy_fp minus;
+    diy_fp cached;
+    diy_fp one;
+    cjson_uint64 delta = 0;
+    cjson_uint64 distance = 0;
+    cjson_uint64 fraction = 0;
+    unsigned int integral = 0;
+    double estimate = 0;
+    int cached_exponent = 0;
+    int index = 0;
+    int kappa = 0;
+    int length = 0;
+
+    memcpy(&bits, &number, sizeof(bits));
+    value.f = bits & CJSON_U64(0x000FFFFF, 0xFFFFFFFF);
+    value.e = (int)((bits >> 52) & 0x7FF);
+    if (value.e != 0)
     {
-        length = sprintf((char*)number_buffer, "%d", item->valueint);
+        value.f += CJSON_U64(0x00100000, 0);
+        value.e -= 1075;
     }
     else
     {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
-
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
-        {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
-        }
+        value.e = -1074;
     }
 
-    /* sprintf failed or buffer overrun occurred */
-    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    /* boundaries halfway to the neighbouring doubles, on the same exponent */
+    plus.f = (value.f << 1) + 1;
+    plus.e = value.e - 1;
+    plus = diy_fp_normalize(plus);
+    if ((value.f == CJSON_U64(0x00100000, 0)) && (value.e > -1074))
     {
-        return false;
+        /* the double below is closer: the exponent drops */
+        minus.f = (value.f << 2) - 1;
+        minus.e = value.e - 2;
     }
+    else
+    {
+        minus.f = (value.f << 1) - 1;
+        minus.e = value.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
 
-    /* reserve appropriate space in the output */
-    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
-    if (output_pointer == NULL)
+    /* scale by a cached power of ten so the binary exponent lands in [-60, -32] */
+    estimate = ((-61 - plus.e) * 0.30102999566398114) + 347;
+    cached_exponent = (int)estimate;
+    if ((estimate - cached_exponent) > 0.0)
     {
-        return false;
+        cached_exponent++;
     }
+    index = (cached_exponent >> 3) + 1;
+    cached = cached_powers[index];
+    *exponent = 348 - (index * 8);
 
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
+    value = diy_fp_multiply(diy_fp_normalize(value), cached);
+    plus = diy_fp_multiply(plus, cached);
+    minus = diy_fp_multiply(minus, cached);
+    /* stay inside the interval despite the rounding of the products */
+    minus.f++;
+    plus.f--;
+
+    delta = plus.f - minus.f;
+    distance = plus.f - value.f;
+    one.e = plus.e;
+    one.f = (cjson_uint64)1 << -one.e;
+    integral = (unsigned int)(plus.f >> -one.e);
+    fraction = plus.f & (one.f - 1);
+
+    /* integral digits */
+    kappa = 10;
+    while ((kappa > 1) && (integral < powers_of_ten_32[kappa - 1]))
+    {
+        kappa--;
+    }
+    while (kappa > 0)
+    {
+        unsigned int digit = integral / powers_of_ten_32[kappa - 1];
+        integral %= powers_of_ten_32[kappa - 1];
+        if ((digit != 0) || (length != 0))
+        {
+            digits[length++] = (unsigned char)('0' + digit);
+        }
+        kappa--;
+        if ((((cjson_uint64)integral << -one.e) + fraction) <= delta)
+        {
+            *exponent += kappa;
+            grisu_round(digits, length, delta, ((cjson_uint64)integral << -one.e) + fraction, (cjson_uint64)powers_of_ten_32[kappa] << -one.e, distance);
+            return length;
+        }
+    }
+
+    /* fractional digits */
+    for (;;)
+    {
+        unsigned char digit = 0;
+        fraction *= 10;
+        delta *= 10;
+        digit = (unsigned char)(fraction >> -one.e);
+        if ((digit != 0) || (length != 0))
+        {
+            digits[length++] = (unsigned char)('0' + digit);
+        }
+        fraction &= one.f - 1;
+        kappa--;
+        if (fraction < delta)
+        {
+            *exponent += kappa;
+            grisu_round(digits, length, delta, fraction, one.f, (-kappa < 20) ? (distance * power_of_ten_64(-kappa)) : 0);
+            return length;
+        }
+    }
+}
+
+/* Print a finite double in the layout of printf's %g: plain notation for decimal
+ * exponents from -4 up to 14 (16 when 16 or 17 digits are needed), else d.ddde+XX. */
+static int print_double(unsigned char *output, double number)
+{
+    unsigned char digits[20];
+    unsigned char *pointer = output;
+    int exponent = 0;
+    int length = 0;
+    int point = 0;
+    int i = 0;
+
+    if (number == 0)
+    {
+        *pointer++ = '0';
+        return (int)(pointer - output);
+    }
+    if (number < 0)
+    {
+        *pointer++ = '-';
+        number = -number;
+    }
+
+    length = grisu2(number, digits, &exponent);
+    /* position of the decimal point relative to the first digit */
+    point = length + exponent;
+
+    if ((point > -4) && (point <= ((length > 15) ? 17 : 15)))
+    {
+        if (point <= 0)
+        {
+            *pointer++ = '0';
+            *pointer++ = '.';
+            for (i = point; i < 0; i++)
+            {
+                *pointer++ = '0';
+            }
+            memcpy(pointer, digits, (size_t)length);
+            pointer += length;
+        }
+        else if (point >= length)
+        {
+            memcpy(pointer, digits, (size_t)length);
+            pointer += length;
+            for (i = length; i < point; i++)
+            {
+                *pointer++ = '0';
+            }
+        }
+        else
+        {
+            memcpy(pointer, digits, (size_t)point);
+            pointer += point;
+            *pointer++ = '.';
+            memcpy(pointer, digits + point, (size_t)(length - point));
+            pointer += length - point;
+        }
+    }
+    else
+    {
+        *pointer++ = digits[0];
+        if (length > 1)
+        {
+            *pointer++ = '.';
+            memcpy(pointer, digits + 1, (size_t)(length - 1));
+            pointer += length - 1;
+        }
+        exponent = point - 1;
+        *pointer++ = 'e';
+        if (exponent < 0)
+        {
+            *pointer++ = '-';
+            exponent = -exponent;
+        }
+        else
+        {
+            *pointer++ = '+';
+        }
+        if (exponent >= 100)
+        {
+            *pointer++ = (unsigned char)('0' + (exponent / 100));
+            exponent %= 100;
+        }
+        *pointer++ = (unsigned char)('0' + (exponent / 10));
+        *pointer++ = (unsigned char)('0' + (exponent % 10));
+    }
+
+    return (int)(pointer - output);
+}
+#endif /* CJSON_FAST_NUMBERS */
+
+/* Print an int without sprintf, returns the length. */
+static int print_int(unsigned char *output, int number)
+{
+    unsigned char digits[16];
+    unsigned int magnitude = (unsigned int)number;
+    int length = 0;
+    int i = 0;
+
+    if (number < 0)
+    {
+        output[i++] = '-';
+        magnitude = 0U - magnitude;
+    }
+    do
+    {
+        digits[length++] = (unsigned char)('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    while (length > 0)
+    {
+        output[i++] = digits[--length];
+    }
+
+    return i;
+}
+
+/* Render the number nicely from the given item into a string. */
+static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    double d = item->valuedouble;
+    int length = 0;
+    size_t i = 0;
+    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
+    unsigned char decimal_point = get_decimal_point();
+#ifndef CJSON_FAST_NUMBERS
+    double test = 0.0;
+#endif
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* This checks for NaN and Infinity */
+    if (isnan(d) || isinf(d))
+    {
+        length = sprintf((char*)number_buffer, "null");
+    }
+    else if(d == (double)item->valueint)
+    {
+        length = print_int(number_buffer, item->valueint);
+    }
+    else
+    {
+#ifdef CJSON_FAST_NUMBERS
+        length = print_double(number_buffer, d);
+#else
+        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
+        length = sprintf((char*)number_buffer, "%1.15g", d);
+
+        /* Check whether the original double can be recovered */
+        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
+        {
+            /* If not, print with 17 decimal places of precision */
+            length = sprintf((char*)number_buffer, "%1.17g", d);
+        }
+#endif
+    }
+
+    /* sprintf failed or buffer overrun occurred */
+    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    {
+        return false;
+    }
+
+    /* reserve appropriate space in the output */
+    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    /* copy the printed number to the output and replace locale
+     * dependent decimal point with '.' */
+    for (i = 0; i < ((size_t)length); i++)
     {
         if (number_buffer[i] == decimal_point)
         {
@@ -815,6 +2205,155 @@ fail:
     return 0;
 }
 
+/* Vectorized scanning: find the next quote or backslash in a string, or the next
+ * non-whitespace byte (> 32), 16 bytes at a time with SSE2 or 32 with AVX2.
+ * AVX2 is picked at runtime. Define CJSON_NO_SIMD to use plain C loops only. */
+#if !defined(CJSON_NO_SIMD) && defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define CJSON_SIMD 1
+#include <immintrin.h>
+#endif
+
+/* index of the first quote or backslash in the n bytes at p, n if none */
+static size_t scan_string_scalar(const unsigned char *p, size_t n)
+{
+    size_t i = 0;
+    while ((i < n) && (p[i] != '\"') && (p[i] != '\\'))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/* index of the first byte that is not whitespace in the n bytes at p, n if none */
+static size_t scan_whitespace_scalar(const unsigned char *p, size_t n)
+{
+    size_t i = 0;
+    while ((i < n) && (p[i] <= 32))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+#ifdef CJSON_SIMD
+static size_t scan_string_sse2(const unsigned char *p, size_t n)
+{
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(p + i));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+        if (mask != 0)
+        {
+            return i + (size_t)__builtin_ctz((unsigned int)mask);
+        }
+    }
+
+    return i + scan_string_scalar(p + i, n - i);
+}
+
+static size_t scan_whitespace_sse2(const unsigned char *p, size_t n)
+{
+    const __m128i space = _mm_set1_epi8(32);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(p + i));
+        /* bytes <= 32 are those where max(byte, 32) == 32 */
+        int mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, space), space)) & 0xFFFF;
+        if (mask != 0)
+        {
+            return i + (size_t)__builtin_ctz((unsigned int)mask);
+        }
+    }
+
+    return i + scan_whitespace_scalar(p + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static size_t scan_string_avx2(const unsigned char *p, size_t n)
+{
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(p + i));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)));
+        if (mask != 0)
+        {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    /* no calls to the SSE2 version here: mixing in legacy SSE code with the
+     * upper halves of the ymm registers dirty is slow on many CPUs */
+    return i + scan_string_scalar(p + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static size_t scan_whitespace_avx2(const unsigned char *p, size_t n)
+{
+    const __m256i space = _mm256_set1_epi8(32);
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(p + i));
+        unsigned int mask = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(chunk, space), space));
+        if (mask != 0)
+        {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    return i + scan_whitespace_scalar(p + i, n - i);
+}
+
+static size_t scan_string_detect(const unsigned char *p, size_t n);
+static size_t scan_whitespace_detect(const unsigned char *p, size_t n);
+static size_t (*scan_string)(const unsigned char *p, size_t n) = scan_string_detect;
+static size_t (*scan_whitespace)(const unsigned char *p, size_t n) = scan_whitespace_detect;
+
+/* pick the implementations on first use */
+static void scan_select(void)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        scan_string = scan_string_avx2;
+        scan_whitespace = scan_whitespace_avx2;
+    }
+    else
+    {
+        scan_string = scan_string_sse2;
+        scan_whitespace = scan_whitespace_sse2;
+    }
+}
+
+static size_t scan_string_detect(const unsigned char *p, size_t n)
+{
+    scan_select();
+    return scan_string(p, n);
+}
+
+static size_t scan_whitespace_detect(const unsigned char *p, size_t n)
+{
+    scan_select();
+    return scan_whitespace(p, n);
+}
+#else
+#define scan_string scan_string_scalar
+#define scan_whitespace scan_whitespace_scalar
+#endif
+
 /* Parse the input text into an unescaped cinput, and populate item. */
 static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
 {
@@ -833,32 +2372,42 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
         /* calculate approximate size of the output (overestimate) */
         size_t allocation_length = 0;
         size_t skipped_bytes = 0;
-        while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
+        while ((size_t)(input_end - input_buffer->content) < input_buffer->length)
         {
+            input_end += scan_string(input_end, input_buffer->length - (size_t)(input_end - input_buffer->content));
+            if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end == '\"'))
+            {
+                break;
+            }
+
             /* is escape sequence */
-            if (input_end[0] == '\\')
+            if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
             {
-                if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
-                {
-                    /* prevent buffer overflow when last input character is a backslash */
-                    goto fail;
-                }
-                skipped_bytes++;
-                input_end++;
+                /* prevent buffer overflow when last input character is a backslash */
+                goto fail;
             }
-            input_end++;
+            skipped_bytes++;
+            input_end += 2;
         }
         if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
         {
             goto fail; /* string ended unexpectedly */
         }
 
-        /* This is at most how much we need for the output */
-        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
-        if (output == NULL)
+        if (input_buffer->in_situ)
         {
-            goto fail; /* allocation failure */
+            /* unescaping only shrinks, the output and its terminator fit up to the closing quote */
+            output = (unsigned char*)input_pointer;
+        }
+        else
+        {
+            /* This is at most how much we need for the output */
+            allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
+            output = (unsigned char*)hooks_allocate(&input_buffer->hooks, allocation_length + sizeof(""));
+            if (output == NULL)
+            {
+                goto fail; /* allocation failure */
+            }
         }
     }
 
@@ -868,7 +2417,20 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     {
         if (*input_pointer != '\\')
         {
-            *output_pointer++ = *input_pointer++;
+            /* copy everything up to the next escape sequence at once. Malformed \u escapes
+             * can leave input_pointer on an escaped quote, which is copied like any other byte */
+            size_t length = 1 + scan_string(input_pointer + 1, (size_t)(input_end - input_pointer) - 1);
+            if (!input_buffer->in_situ)
+            {
+                memcpy(output_pointer, input_pointer, length);
+            }
+            else if (output_pointer != input_pointer)
+            {
+                /* in situ the output trails the input in the same buffer */
+                memmove(output_pointer, input_pointer, length);
+            }
+            output_pointer += length;
+            input_pointer += length;
         }
         /* escape sequence */
         else
@@ -922,7 +2484,8 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     /* zero terminate the output */
     *output_pointer = '\0';
 
-    item->type = cJSON_String;
+    /* in situ the string belongs to the input, cJSON_Delete must not free it */
+    item->type = input_buffer->in_situ ? (cJSON_String | cJSON_IsReference) : cJSON_String;
     item->valuestring = (char*)output;
 
     input_buffer->offset = (size_t) (input_end - input_buffer->content);
@@ -931,9 +2494,9 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     return true;
 
 fail:
-    if (output != NULL)
+    if ((output != NULL) && !input_buffer->in_situ)
     {
-        input_buffer->hooks.deallocate(output);
+        hooks_deallocate(&input_buffer->hooks, output);
         output = NULL;
     }
 
@@ -1094,9 +2657,10 @@ static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
         return buffer;
     }
 
-    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
+    /* most calls find no whitespace at all, don't pay for a scan then */
+    if (buffer_at_offset(buffer)[0] <= 32)
     {
-       buffer->offset++;
+        buffer->offset += scan_whitespace(buffer_at_offset(buffer), buffer->length - buffer->offset);
     }
 
     if (buffer->offset == buffer->length)
@@ -1139,9 +2703,9 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return
 }
 
 /* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+static cJSON *parse_with_hooks(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, const internal_hooks * const hooks, cJSON_bool in_situ)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0 };
     cJSON *item = NULL;
 
     /* reset error position */
@@ -1156,9 +2720,10 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer
     buffer.content = (const unsigned char*)value;
     buffer.length = buffer_length;
     buffer.offset = 0;
-    buffer.hooks = global_hooks;
+    buffer.hooks = *hooks;
+    buffer.in_situ = in_situ;
 
-    item = cJSON_New_Item(&global_hooks);
+    item = cJSON_New_Item(hooks);
     if (item == NULL) /* memory fail */
     {
         goto fail;
@@ -1170,67 +2735,1474 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer
         goto fail;
     }
 
-    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
-    if (require_null_terminated)
-    {
-        buffer_skip_whitespace(&buffer);
-        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
-        {
-            goto fail;
-        }
-    }
-    if (return_parse_end)
-    {
-        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if (require_null_terminated)
+    {
+        buffer_skip_whitespace(&buffer);
+        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        {
+            goto fail;
+        }
+    }
+    if (return_parse_end)
+    {
+        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+    }
+
+    return item;
+
+fail:
+    if (item != NULL)
+    {
+        hooks_delete(item, hooks);
+    }
+
+    if (value != NULL)
+    {
+        error local_error;
+        local_error.json = (const unsigned char*)value;
+        local_error.position = 0;
+
+        if (buffer.offset < buffer.length)
+        {
+            local_error.position = buffer.offset;
+        }
+        else if (buffer.length > 0)
+        {
+            local_error.position = buffer.length - 1;
+        }
+
+        if (return_parse_end != NULL)
+        {
+            *return_parse_end = (const char*)local_error.json + local_error.position;
+        }
+
+        global_error = local_error;
+    }
+
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    return parse_with_hooks(value, buffer_length, return_parse_end, require_null_terminated, &global_hooks, false);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSituOpts(char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    return parse_with_hooks(value, buffer_length, return_parse_end, require_null_terminated, &global_hooks, true);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value, size_t buffer_length)
+{
+    return cJSON_ParseInSituOpts(value, buffer_length, 0, 0);
+}
+
+CJSON_PUBLIC(void) cJSON_InitArena(cJSON_Arena *arena, void *buffer, size_t size)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    arena->buffer = (unsigned char*)buffer;
+    arena->size = (buffer != NULL) ? size : 0;
+    arena->used = 0;
+    arena->last = 0;
+}
+
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena)
+{
+    if (arena != NULL)
+    {
+        arena->used = 0;
+        arena->last = 0;
+    }
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInArenaOpts(cJSON_Arena *arena, const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    internal_hooks hooks = global_hooks;
+    size_t mark = 0;
+    cJSON *item = NULL;
+
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    hooks.arena = arena;
+    mark = arena->used;
+    item = parse_with_hooks(value, buffer_length, return_parse_end, require_null_terminated, &hooks, false);
+    if (item == NULL)
+    {
+        /* give back everything the failed parse took */
+        arena->used = mark;
+        arena->last = mark;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInArena(cJSON_Arena *arena, const char *value, size_t buffer_length)
+{
+    return cJSON_ParseInArenaOpts(arena, value, buffer_length, 0, 0);
+}
+
+/* Default options for cJSON_Parse */
+CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+{
+    return cJSON_ParseWithOpts(value, 0, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+{
+    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+}
+
+/* Incremental parsing. The stream keeps only the open arrays/objects (one level each), the
+ * string or number being read and the pending member name between chunks. Strings and numbers
+ * are collected whole and decoded by parse_string/parse_number, so values come out exactly as
+ * cJSON_Parse makes them. */
+typedef enum
+{
+    stream_value,         /* a value is expected */
+    stream_array_first,   /* after '[': a value or ']' */
+    stream_object_first,  /* after '{': a key or '}' */
+    stream_key,           /* after ',' in an object */
+    stream_colon,
+    stream_after_value,   /* ',' or the end of the array/object */
+    stream_string,
+    stream_number,
+    stream_literal,
+    stream_done,
+    stream_error
+} stream_state;
+
+typedef struct
+{
+    cJSON *container; /* NULL with a handler */
+    cJSON_bool is_object;
+} stream_level;
+
+struct cJSON_Stream
+{
+    cJSON_StreamHandler handler;
+    cJSON_bool has_handler;
+    internal_hooks hooks;
+    stream_state state;
+    stream_level *levels;
+    size_t depth;
+    size_t levels_size;
+    /* the string (with its quotes) or number being read */
+    unsigned char *token;
+    size_t token_length;
+    size_t token_size;
+    cJSON_bool escaped;
+    cJSON_bool token_is_key;
+    char *key; /* name of the next object member */
+    const char *literal;
+    size_t literal_offset;
+    size_t bom_length;
+    size_t offset;
+    cJSON *root;
+};
+
+CJSON_PUBLIC(cJSON_Stream *) cJSON_CreateStream(const cJSON_StreamHandler *handler)
+{
+    cJSON_Stream *stream = (cJSON_Stream*)global_hooks.allocate(sizeof(cJSON_Stream));
+    if (stream == NULL)
+    {
+        return NULL;
+    }
+
+    memset(stream, '\0', sizeof(cJSON_Stream));
+    stream->hooks = global_hooks;
+    stream->state = stream_value;
+    if (handler != NULL)
+    {
+        stream->handler = *handler;
+        stream->has_handler = true;
+    }
+
+    return stream;
+}
+
+static cJSON_bool stream_append(cJSON_Stream * const stream, const unsigned char *bytes, size_t length)
+{
+    if (length > (stream->token_size - stream->token_length))
+    {
+        size_t new_size = (stream->token_size == 0) ? 64 : stream->token_size;
+        unsigned char *new_token = NULL;
+
+        while (new_size < (stream->token_length + length))
+        {
+            if (new_size > (((size_t)-1) / 2))
+            {
+                return false;
+            }
+            new_size *= 2;
+        }
+
+        new_token = (unsigned char*)stream->hooks.allocate(new_size);
+        if (new_token == NULL)
+        {
+            return false;
+        }
+        if (stream->token != NULL)
+        {
+            memcpy(new_token, stream->token, stream->token_length);
+            stream->hooks.deallocate(stream->token);
+        }
+        stream->token = new_token;
+        stream->token_size = new_size;
+    }
+
+    memcpy(stream->token + stream->token_length, bytes, length);
+    stream->token_length += length;
+
+    return true;
+}
+
+/* a new item, or the caller's temporary one when only reporting to a handler */
+static cJSON *stream_new_item(const cJSON_Stream * const stream, cJSON *temporary)
+{
+    if (stream->has_handler)
+    {
+        memset(temporary, '\0', sizeof(cJSON));
+        return temporary;
+    }
+
+    return cJSON_New_Item(&stream->hooks);
+}
+
+/* Hand a parsed value, or an array/object that was just opened, to the handler or the tree.
+ * Consumes the item when reporting to a handler. */
+static cJSON_bool stream_add(cJSON_Stream * const stream, cJSON * const item)
+{
+    cJSON_bool success = true;
+
+    if (stream->has_handler)
+    {
+        if (stream->handler.value != NULL)
+        {
+            success = stream->handler.value(stream->handler.user_data, stream->key, item);
+        }
+        if (item->valuestring != NULL)
+        {
+            stream->hooks.deallocate(item->valuestring);
+            item->valuestring = NULL;
+        }
+        if (stream->key != NULL)
+        {
+            stream->hooks.deallocate(stream->key);
+            stream->key = NULL;
+        }
+
+        return success;
+    }
+
+    if (stream->depth == 0)
+    {
+        stream->root = item;
+    }
+    else
+    {
+        cJSON *parent = stream->levels[stream->depth - 1].container;
+
+        item->string = stream->key;
+        stream->key = NULL;
+        /* like add_item_to_array: the first child's prev is the last child */
+        if (parent->child == NULL)
+        {
+            parent->child = item;
+            item->prev = item;
+        }
+        else
+        {
+            parent->child->prev->next = item;
+            item->prev = parent->child->prev;
+            parent->child->prev = item;
+        }
+    }
+
+    return true;
+}
+
+/* after a complete value: done at the top level, else look for ',' or the closing bracket */
+static void stream_value_done(cJSON_Stream * const stream)
+{
+    stream->state = (stream->depth == 0) ? stream_done : stream_after_value;
+}
+
+static cJSON_bool stream_open(cJSON_Stream * const stream, cJSON_bool is_object)
+{
+    cJSON temporary;
+    cJSON *item = NULL;
+
+    if (stream->depth >= CJSON_NESTING_LIMIT)
+    {
+        return false; /* to deeply nested */
+    }
+
+    if (stream->depth == stream->levels_size)
+    {
+        size_t new_size = (stream->levels_size == 0) ? 16 : (stream->levels_size * 2);
+        stream_level *new_levels = (stream_level*)stream->hooks.allocate(new_size * sizeof(stream_level));
+        if (new_levels == NULL)
+        {
+            return false;
+        }
+        if (stream->levels != NULL)
+        {
+            memcpy(new_levels, stream->levels, stream->depth * sizeof(stream_level));
+            stream->hooks.deallocate(stream->levels);
+        }
+        stream->levels = new_levels;
+        stream->levels_size = new_size;
+    }
+
+    item = stream_new_item(stream, &temporary);
+    if (item == NULL)
+    {
+        return false;
+    }
+    item->type = is_object ? cJSON_Object : cJSON_Array;
+    if (!stream_add(stream, item))
+    {
+        return false;
+    }
+
+    stream->levels[stream->depth].container = stream->has_handler ? NULL : item;
+    stream->levels[stream->depth].is_object = is_object;
+    stream->depth++;
+    stream->state = is_object ? stream_object_first : stream_array_first;
+
+    return true;
+}
+
+static cJSON_bool stream_close(cJSON_Stream * const stream, cJSON_bool is_object)
+{
+    if ((stream->depth == 0) || (stream->levels[stream->depth - 1].is_object != is_object))
+    {
+        return false;
+    }
+
+    stream->depth--;
+    if (stream->has_handler && (stream->handler.end != NULL) && !stream->handler.end(stream->handler.user_data))
+    {
+        return false;
+    }
+    stream_value_done(stream);
+
+    return true;
+}
+
+/* decode the collected string or number */
+static cJSON_bool stream_token_done(cJSON_Stream * const stream)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0 };
+    cJSON temporary;
+    cJSON *item = NULL;
+    cJSON_bool success = false;
+
+    buffer.content = stream->token;
+    buffer.length = stream->token_length;
+    buffer.hooks = stream->hooks;
+
+    if ((stream->state == stream_string) && stream->token_is_key)
+    {
+        memset(&temporary, '\0', sizeof(cJSON));
+        if (!parse_string(&temporary, &buffer))
+        {
+            return false;
+        }
+        stream->key = temporary.valuestring;
+        stream->token_length = 0;
+        stream->state = stream_colon;
+
+        return true;
+    }
+
+    item = stream_new_item(stream, &temporary);
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    if (stream->state == stream_string)
+    {
+        success = parse_string(item, &buffer);
+    }
+    else
+    {
+        /* all of it has to be the number, "1.2.3" is not "1.2" followed by ".3" */
+        success = parse_number(item, &buffer) && (buffer.offset == buffer.length);
+    }
+    stream->token_length = 0;
+
+    if (!success)
+    {
+        if (item->valuestring != NULL)
+        {
+            stream->hooks.deallocate(item->valuestring);
+        }
+        if (item != &temporary)
+        {
+            stream->hooks.deallocate(item);
+        }
+        return false;
+    }
+
+    if (!stream_add(stream, item))
+    {
+        return false;
+    }
+    stream_value_done(stream);
+
+    return true;
+}
+
+static cJSON_bool stream_literal_done(cJSON_Stream * const stream)
+{
+    cJSON temporary;
+    cJSON *item = stream_new_item(stream, &temporary);
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    switch (stream->literal[0])
+    {
+        case 't':
+            item->type = cJSON_True;
+            item->valueint = 1;
+            break;
+        case 'f':
+            item->type = cJSON_False;
+            break;
+        default:
+            item->type = cJSON_NULL;
+            break;
+    }
+
+    if (!stream_add(stream, item))
+    {
+        return false;
+    }
+    stream_value_done(stream);
+
+    return true;
+}
+
+static cJSON_bool stream_start_string(cJSON_Stream * const stream, cJSON_bool is_key)
+{
+    stream->state = stream_string;
+    stream->token_is_key = is_key;
+    stream->escaped = false;
+    stream->token_length = 0;
+
+    return stream_append(stream, (const unsigned char*)"\"", 1);
+}
+
+/* the first byte of a value */
+static cJSON_bool stream_start_value(cJSON_Stream * const stream, unsigned char byte)
+{
+    switch (byte)
+    {
+        case '{':
+            return stream_open(stream, true);
+
+        case '[':
+            return stream_open(stream, false);
+
+        case '\"':
+            return stream_start_string(stream, false);
+
+        case 't':
+            stream->literal = "true";
+            break;
+
+        case 'f':
+            stream->literal = "false";
+            break;
+
+        case 'n':
+            stream->literal = "null";
+            break;
+
+        default:
+            if ((byte == '-') || ((byte >= '0') && (byte <= '9')))
+            {
+                stream->state = stream_number;
+                stream->token_length = 0;
+                return stream_append(stream, &byte, 1);
+            }
+            return false;
+    }
+
+    stream->state = stream_literal;
+    stream->literal_offset = 1;
+
+    return true;
+}
+
+static void stream_fail(cJSON_Stream * const stream)
+{
+    stream->state = stream_error;
+    if (stream->root != NULL)
+    {
+        cJSON_Delete(stream->root);
+        stream->root = NULL;
+    }
+}
+
+CJSON_PUBLIC(int) cJSON_StreamFeed(cJSON_Stream *stream, const char *chunk, size_t length)
+{
+    const unsigned char *pointer = (const unsigned char*)chunk;
+    const unsigned char *end = pointer + length;
+
+    if ((stream == NULL) || ((chunk == NULL) && (length != 0)))
+    {
+        return cJSON_StreamError;
+    }
+
+    /* a UTF-8 BOM may precede the document */
+    while ((stream->bom_length < 3) && (stream->offset == stream->bom_length) && (pointer < end))
+    {
+        if (*pointer != (unsigned char)"\xEF\xBB\xBF"[stream->bom_length])
+        {
+            if (stream->bom_length != 0)
+            {
+                stream_fail(stream);
+            }
+            break;
+        }
+        stream->bom_length++;
+        stream->offset++;
+        pointer++;
+    }
+
+    while ((pointer < end) && (stream->state != stream_error))
+    {
+        const unsigned char *start = pointer;
+        cJSON_bool success = true;
+
+        switch (stream->state)
+        {
+            case stream_string:
+                if (stream->escaped)
+                {
+                    stream->escaped = false;
+                    success = stream_append(stream, pointer, 1);
+                    pointer++;
+                    break;
+                }
+                pointer += scan_string(pointer, (size_t)(end - pointer));
+                success = stream_append(stream, start, (size_t)(pointer - start));
+                if (success && (pointer < end))
+                {
+                    success = stream_append(stream, pointer, 1);
+                    if (*pointer == '\\')
+                    {
+                        stream->escaped = true;
+                    }
+                    else if (success)
+                    {
+                        success = stream_token_done(stream);
+                    }
+                    pointer++;
+                }
+                break;
+
+            case stream_number:
+                while ((pointer < end) && (((*pointer >= '0') && (*pointer <= '9')) || (*pointer == '.') || (*pointer == 'e') || (*pointer == 'E') || (*pointer == '+') || (*pointer == '-')))
+                {
+                    pointer++;
+                }
+                success = stream_append(stream, start, (size_t)(pointer - start));
+                if (success && (pointer < end))
+                {
+                    /* the byte after the number is looked at again in the next state */
+                    success = stream_token_done(stream);
+                }
+                break;
+
+            case stream_literal:
+                if (*pointer != (unsigned char)stream->literal[stream->literal_offset])
+                {
+                    success = false;
+                    break;
+                }
+                pointer++;
+                stream->literal_offset++;
+                if (stream->literal[stream->literal_offset] == '\0')
+                {
+                    success = stream_literal_done(stream);
+                }
+                break;
+
+            default:
+                if (*pointer <= 32)
+                {
+                    /* same whitespace as buffer_skip_whitespace */
+                    pointer += scan_whitespace(pointer, (size_t)(end - pointer));
+                    break;
+                }
+
+                switch (stream->state)
+                {
+                    case stream_array_first:
+                        success = (*pointer == ']') ? stream_close(stream, false) : stream_start_value(stream, *pointer);
+                        break;
+
+                    case stream_value:
+                        success = stream_start_value(stream, *pointer);
+                        break;
+
+                    case stream_object_first:
+                        if (*pointer == '}')
+                        {
+                            success = stream_close(stream, true);
+                            break;
+                        }
+                        success = (*pointer == '\"') && stream_start_string(stream, true);
+                        break;
+
+                    case stream_key:
+                        success = (*pointer == '\"') && stream_start_string(stream, true);
+                        break;
+
+                    case stream_colon:
+                        success = (*pointer == ':');
+                        stream->state = stream_value;
+                        break;
+
+                    case stream_after_value:
+                        if (*pointer == ',')
+                        {
+                            stream->state = stream->levels[stream->depth - 1].is_object ? stream_key : stream_value;
+                        }
+                        else
+                        {
+                            success = ((*pointer == ']') || (*pointer == '}')) && stream_close(stream, *pointer == '}');
+                        }
+                        break;
+
+                    default:
+                        /* only whitespace may follow the document */
+                        success = false;
+                        break;
+                }
+                if (success)
+                {
+                    pointer++;
+                }
+                break;
+        }
+
+        if (!success)
+        {
+            stream->offset += (size_t)(pointer - start);
+            stream_fail(stream);
+            break;
+        }
+        stream->offset += (size_t)(pointer - start);
+    }
+
+    switch (stream->state)
+    {
+        case stream_error:
+            return cJSON_StreamError;
+        case stream_done:
+            return cJSON_StreamDone;
+        default:
+            return cJSON_StreamMore;
+    }
+}
+
+CJSON_PUBLIC(int) cJSON_StreamFinish(cJSON_Stream *stream)
+{
+    if (stream == NULL)
+    {
+        return cJSON_StreamError;
+    }
+
+    /* a number at the top level only ends with the input */
+    if ((stream->state == stream_number) && (stream->depth == 0) && !stream_token_done(stream))
+    {
+        stream_fail(stream);
+    }
+
+    if (stream->state != stream_done)
+    {
+        stream_fail(stream);
+        return cJSON_StreamError;
+    }
+
+    return cJSON_StreamDone;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_StreamTakeResult(cJSON_Stream *stream)
+{
+    cJSON *root = NULL;
+
+    if ((stream == NULL) || (stream->state != stream_done))
+    {
+        return NULL;
+    }
+
+    root = stream->root;
+    stream->root = NULL;
+
+    return root;
+}
+
+CJSON_PUBLIC(size_t) cJSON_StreamOffset(const cJSON_Stream *stream)
+{
+    return (stream != NULL) ? stream->offset : 0;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteStream(cJSON_Stream *stream)
+{
+    if (stream == NULL)
+    {
+        return;
+    }
+
+    if (stream->root != NULL)
+    {
+        cJSON_Delete(stream->root);
+    }
+    if (stream->key != NULL)
+    {
+        stream->hooks.deallocate(stream->key);
+    }
+    if (stream->token != NULL)
+    {
+        stream->hooks.deallocate(stream->token);
+    }
+    if (stream->levels != NULL)
+    {
+        stream->hooks.deallocate(stream->levels);
+    }
+    stream->hooks.deallocate(stream);
+}
+
+#define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
+
+/* Tapes: a read-only alternative to the item tree for large documents that are mostly looked up.
+ * The document is a single array of 64 bit words in document order, with a tag in the low byte
+ * of each word and a payload in the rest:
+ *   'n' 't' 'f'  null, true, false
+ *   'd'          a number, its double is stored in the word(s) that follow
+ *   '"'          a string, the payload is its offset in the strings
+ *   ':'          the name of an object member, like a string, right before the member's value
+ *   '[' '{'      the payload is the position of the matching ']' or '}'
+ *   ']' '}'      the payload is the number of elements/members
+ * The strings are unescaped, '\0' terminated and packed back to back in one allocation. A value
+ * thus costs one word (two for numbers and members) instead of a cJSON item and a string
+ * allocation, and walking a document reads memory in order. Positions of members point to
+ * their name, the functions below look past it. */
+struct cJSON_Tape
+{
+    internal_hooks hooks;
+    cjson_uint64 *words;
+    size_t length;
+    size_t size;
+    unsigned char *strings;
+};
+
+#define tape_tag(word) ((unsigned char)((word) & 0xFF))
+#define tape_payload(word) ((size_t)((word) >> 8))
+#define TAPE_PAYLOAD_MAX (((cjson_uint64)-1) >> 8)
+/* words after a 'd' that hold the double */
+#define TAPE_NUMBER_WORDS ((sizeof(double) + sizeof(cjson_uint64) - 1) / sizeof(cjson_uint64))
+#define tape_can_access(tape, position) (((tape) != NULL) && ((position) < (tape)->length))
+
+/* resize one of the tape's allocations, keeping its first length bytes */
+static void *tape_resize(const internal_hooks * const hooks, void *pointer, size_t length, size_t size)
+{
+    void *resized = NULL;
+
+    if (hooks->reallocate != NULL)
+    {
+        return hooks->reallocate(pointer, size);
+    }
+
+    resized = hooks->allocate(size);
+    if (resized == NULL)
+    {
+        return NULL;
+    }
+    memcpy(resized, pointer, cjson_min(length, size));
+    hooks->deallocate(pointer);
+
+    return resized;
+}
+
+static cJSON_bool tape_reserve(cJSON_Tape * const tape, size_t count)
+{
+    cjson_uint64 *words = NULL;
+    size_t new_size = 0;
+
+    if (count <= (tape->size - tape->length))
+    {
+        return true;
+    }
+
+    if (tape->size > ((((size_t)-1) / sizeof(cjson_uint64)) - count) / 2)
+    {
+        return false;
+    }
+    new_size = (tape->size * 2) + count;
+
+    words = (cjson_uint64*)tape_resize(&tape->hooks, tape->words, tape->length * sizeof(cjson_uint64), new_size * sizeof(cjson_uint64));
+    if (words == NULL)
+    {
+        return false;
+    }
+    tape->words = words;
+    tape->size = new_size;
+
+    return true;
+}
+
+static cJSON_bool tape_push(cJSON_Tape * const tape, unsigned char tag, size_t payload)
+{
+    if ((payload > (size_t)TAPE_PAYLOAD_MAX) || !tape_reserve(tape, 1))
+    {
+        return false;
+    }
+
+    tape->words[tape->length] = ((cjson_uint64)payload << 8) | (cjson_uint64)tag;
+    tape->length++;
+
+    return true;
+}
+
+/* the position after the value at position */
+static size_t tape_skip(const cJSON_Tape * const tape, size_t position)
+{
+    switch (tape_tag(tape->words[position]))
+    {
+        case 'd':
+            return position + 1 + TAPE_NUMBER_WORDS;
+
+        case '[':
+        case '{':
+            return tape_payload(tape->words[position]) + 1;
+
+        default:
+            return position + 1;
+    }
+}
+
+/* the value of a member, any other value as is */
+static size_t tape_value(const cJSON_Tape * const tape, size_t position)
+{
+    if (tape_tag(tape->words[position]) == ':')
+    {
+        return position + 1;
+    }
+
+    return position;
+}
+
+/* strings are unescaped in place in the tape's copy of the input, only their offset goes on the tape */
+static cJSON_bool tape_parse_string(cJSON_Tape * const tape, parse_buffer * const input_buffer, cJSON * const item, unsigned char tag)
+{
+    if (cannot_access_at_index(input_buffer, 0) || !parse_string(item, input_buffer))
+    {
+        return false;
+    }
+
+    return tape_push(tape, tag, (size_t)((unsigned char*)item->valuestring - tape->strings));
+}
+
+static cJSON_bool tape_parse_name(cJSON_Tape * const tape, parse_buffer * const input_buffer, cJSON * const item)
+{
+    buffer_skip_whitespace(input_buffer);
+    if (!tape_parse_string(tape, input_buffer, item, ':'))
+    {
+        return false;
+    }
+
+    buffer_skip_whitespace(input_buffer);
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+    {
+        return false;
+    }
+    input_buffer->offset++;
+
+    return true;
+}
+
+/* anything but an array or object, the same way parse_value does it */
+static cJSON_bool tape_parse_scalar(cJSON_Tape * const tape, parse_buffer * const input_buffer, cJSON * const item)
+{
+    const unsigned char *value = buffer_at_offset(input_buffer);
+
+    if (can_read(input_buffer, 4) && (strncmp((const char*)value, "null", 4) == 0))
+    {
+        input_buffer->offset += 4;
+        return tape_push(tape, 'n', 0);
+    }
+    if (can_read(input_buffer, 5) && (strncmp((const char*)value, "false", 5) == 0))
+    {
+        input_buffer->offset += 5;
+        return tape_push(tape, 'f', 0);
+    }
+    if (can_read(input_buffer, 4) && (strncmp((const char*)value, "true", 4) == 0))
+    {
+        input_buffer->offset += 4;
+        return tape_push(tape, 't', 0);
+    }
+    if (value[0] == '\"')
+    {
+        return tape_parse_string(tape, input_buffer, item, '\"');
+    }
+    if ((value[0] == '-') || ((value[0] >= '0') && (value[0] <= '9')))
+    {
+        if (!parse_number(item, input_buffer) || !tape_reserve(tape, 1 + TAPE_NUMBER_WORDS))
+        {
+            return false;
+        }
+        tape->words[tape->length] = 'd';
+        memcpy(tape->words + tape->length + 1, &item->valuedouble, sizeof(double));
+        tape->length += 1 + TAPE_NUMBER_WORDS;
+        return true;
+    }
+
+    return false;
+}
+
+/* Close the innermost array/object. While it is open, the payload of its first word is the position
+ * (plus one) of the one around it; now it gets the position of the end, and the end the count. */
+static cJSON_bool tape_close(cJSON_Tape * const tape, size_t * const open)
+{
+    size_t start = *open - 1;
+    size_t position = *open;
+    size_t count = 0;
+    unsigned char tag = tape_tag(tape->words[start]);
+
+    while (position < tape->length)
+    {
+        position = tape_skip(tape, tape_value(tape, position));
+        count++;
+    }
+
+    if ((tape->length > (size_t)TAPE_PAYLOAD_MAX) || !tape_push(tape, (tag == '[') ? ']' : '}', count))
+    {
+        return false;
+    }
+
+    *open = tape_payload(tape->words[start]);
+    tape->words[start] = ((cjson_uint64)(tape->length - 1) << 8) | (cjson_uint64)tag;
+
+    return true;
+}
+
+/* Iterative, the tape itself links the open arrays/objects. Accepts exactly what parse_value does. */
+static cJSON_bool tape_parse(cJSON_Tape * const tape, parse_buffer * const input_buffer)
+{
+    cJSON item;
+    size_t open = 0;
+    unsigned char byte = 0;
+    unsigned char closing = 0;
+
+    memset(&item, '\0', sizeof(item));
+
+    for (;;)
+    {
+        /* a value */
+        buffer_skip_whitespace(input_buffer);
+        if (cannot_access_at_index(input_buffer, 0))
+        {
+            return false;
+        }
+        byte = buffer_at_offset(input_buffer)[0];
+        if ((byte == '[') || (byte == '{'))
+        {
+            if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+            {
+                return false; /* to deeply nested */
+            }
+            input_buffer->depth++;
+
+            if (!tape_push(tape, byte, open))
+            {
+                return false;
+            }
+            open = tape->length;
+
+            input_buffer->offset++;
+            buffer_skip_whitespace(input_buffer);
+            if (cannot_access_at_index(input_buffer, 0))
+            {
+                return false;
+            }
+            if (buffer_at_offset(input_buffer)[0] != ((byte == '[') ? ']' : '}'))
+            {
+                if ((byte == '{') && !tape_parse_name(tape, input_buffer, &item))
+                {
+                    return false;
+                }
+                continue;
+            }
+            /* empty, closed right below */
+        }
+        else if (!tape_parse_scalar(tape, input_buffer, &item))
+        {
+            return false;
+        }
+
+        /* after a value: a ',' or the end of the arrays/objects around it */
+        for (;;)
+        {
+            if (open == 0)
+            {
+                return true;
+            }
+
+            buffer_skip_whitespace(input_buffer);
+            if (cannot_access_at_index(input_buffer, 0))
+            {
+                return false;
+            }
+            byte = buffer_at_offset(input_buffer)[0];
+            closing = (tape_tag(tape->words[open - 1]) == '[') ? ']' : '}';
+
+            if (byte == ',')
+            {
+                input_buffer->offset++;
+                if ((closing == '}') && !tape_parse_name(tape, input_buffer, &item))
+                {
+                    return false;
+                }
+                break;
+            }
+            if ((byte != closing) || !tape_close(tape, &open))
+            {
+                return false;
+            }
+            input_buffer->depth--;
+            input_buffer->offset++;
+        }
+    }
+}
+
+/* move the strings to the front of the copy of the input, in order, and drop the rest */
+static size_t tape_pack_strings(cJSON_Tape * const tape)
+{
+    size_t position = 0;
+    size_t used = 0;
+
+    while (position < tape->length)
+    {
+        unsigned char tag = tape_tag(tape->words[position]);
+        if ((tag == '\"') || (tag == ':'))
+        {
+            unsigned char *string = tape->strings + tape_payload(tape->words[position]);
+            size_t length = strlen((const char*)string) + sizeof("");
+
+            memmove(tape->strings + used, string, length);
+            tape->words[position] = ((cjson_uint64)used << 8) | (cjson_uint64)tag;
+            used += length;
+        }
+
+        position += (tag == 'd') ? (1 + TAPE_NUMBER_WORDS) : 1;
+    }
+
+    return used;
+}
+
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTapeOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0, 0 }, 0 };
+    cJSON_Tape *tape = NULL;
+    void *resized = NULL;
+    size_t used = 0;
+
+    /* reset error position */
+    global_error.json = NULL;
+    global_error.position = 0;
+
+    if ((value == NULL) || (0 == buffer_length))
+    {
+        goto fail;
+    }
+
+    tape = (cJSON_Tape*)global_hooks.allocate(sizeof(cJSON_Tape));
+    if (tape == NULL)
+    {
+        goto fail;
+    }
+    memset(tape, '\0', sizeof(cJSON_Tape));
+    tape->hooks = global_hooks;
+
+    /* strings are unescaped in a copy of the input, which is packed afterwards */
+    tape->strings = (unsigned char*)tape->hooks.allocate(buffer_length);
+    if (tape->strings == NULL)
+    {
+        goto fail;
+    }
+    memcpy(tape->strings, value, buffer_length);
+
+    tape->size = (buffer_length / 8) + 16;
+    tape->words = (cjson_uint64*)tape->hooks.allocate(tape->size * sizeof(cjson_uint64));
+    if (tape->words == NULL)
+    {
+        goto fail;
+    }
+
+    buffer.content = tape->strings;
+    buffer.length = buffer_length;
+    buffer.offset = 0;
+    buffer.hooks = global_hooks;
+    buffer.in_situ = true;
+
+    if (!tape_parse(tape, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    {
+        goto fail;
+    }
+
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if (require_null_terminated)
+    {
+        buffer_skip_whitespace(&buffer);
+        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        {
+            goto fail;
+        }
+    }
+    if (return_parse_end)
+    {
+        *return_parse_end = value + buffer.offset;
+    }
+
+    /* give back what the document doesn't use, failing to do so is harmless */
+    used = tape_pack_strings(tape);
+    resized = tape_resize(&tape->hooks, tape->strings, used, (used > 0) ? used : 1);
+    if (resized != NULL)
+    {
+        tape->strings = (unsigned char*)resized;
+    }
+    resized = tape_resize(&tape->hooks, tape->words, tape->length * sizeof(cjson_uint64), tape->length * sizeof(cjson_uint64));
+    if (resized != NULL)
+    {
+        tape->words = (cjson_uint64*)resized;
+        tape->size = tape->length;
+    }
+
+    return tape;
+
+fail:
+    cJSON_DeleteTape(tape);
+
+    if (value != NULL)
+    {
+        error local_error;
+        local_error.json = (const unsigned char*)value;
+        local_error.position = 0;
+
+        if (buffer.offset < buffer.length)
+        {
+            local_error.position = buffer.offset;
+        }
+        else if (buffer.length > 0)
+        {
+            local_error.position = buffer.length - 1;
+        }
+
+        if (return_parse_end != NULL)
+        {
+            *return_parse_end = (const char*)local_error.json + local_error.position;
+        }
+
+        global_error = local_error;
+    }
+
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTape(const char *value, size_t buffer_length)
+{
+    return cJSON_ParseTapeOpts(value, buffer_length, 0, 0);
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteTape(cJSON_Tape *tape)
+{
+    if (tape == NULL)
+    {
+        return;
+    }
+
+    if (tape->words != NULL)
+    {
+        tape->hooks.deallocate(tape->words);
+    }
+    if (tape->strings != NULL)
+    {
+        tape->hooks.deallocate(tape->strings);
+    }
+    tape->hooks.deallocate(tape);
+}
+
+CJSON_PUBLIC(int) cJSON_TapeType(const cJSON_Tape *tape, size_t position)
+{
+    if (!tape_can_access(tape, position))
+    {
+        return cJSON_Invalid;
+    }
+
+    switch (tape_tag(tape->words[tape_value(tape, position)]))
+    {
+        case 'n':
+            return cJSON_NULL;
+        case 't':
+            return cJSON_True;
+        case 'f':
+            return cJSON_False;
+        case 'd':
+            return cJSON_Number;
+        case '\"':
+            return cJSON_String;
+        case '[':
+            return cJSON_Array;
+        case '{':
+            return cJSON_Object;
+        default:
+            return cJSON_Invalid;
+    }
+}
+
+CJSON_PUBLIC(double) cJSON_TapeNumber(const cJSON_Tape *tape, size_t position)
+{
+    double number = 0;
+
+    if (cJSON_TapeType(tape, position) != cJSON_Number)
+    {
+        return (double) NAN;
+    }
+
+    memcpy(&number, tape->words + tape_value(tape, position) + 1, sizeof(double));
+
+    return number;
+}
+
+CJSON_PUBLIC(const char *) cJSON_TapeString(const cJSON_Tape *tape, size_t position)
+{
+    if (cJSON_TapeType(tape, position) != cJSON_String)
+    {
+        return NULL;
+    }
+
+    return (const char*)tape->strings + tape_payload(tape->words[tape_value(tape, position)]);
+}
+
+CJSON_PUBLIC(const char *) cJSON_TapeName(const cJSON_Tape *tape, size_t position)
+{
+    if (!tape_can_access(tape, position) || (tape_tag(tape->words[position]) != ':'))
+    {
+        return NULL;
+    }
+
+    return (const char*)tape->strings + tape_payload(tape->words[position]);
+}
+
+CJSON_PUBLIC(int) cJSON_TapeSize(const cJSON_Tape *tape, size_t position)
+{
+    size_t count = 0;
+    int type = cJSON_TapeType(tape, position);
+
+    if ((type != cJSON_Array) && (type != cJSON_Object))
+    {
+        return 0;
+    }
+
+    count = tape_payload(tape->words[tape_payload(tape->words[tape_value(tape, position)])]);
+
+    /* int, to match cJSON_GetArraySize */
+    return (count > INT_MAX) ? INT_MAX : (int)count;
+}
+
+CJSON_PUBLIC(size_t) cJSON_TapeChild(const cJSON_Tape *tape, size_t position)
+{
+    int type = cJSON_TapeType(tape, position);
+    size_t child = 0;
+
+    if ((type != cJSON_Array) && (type != cJSON_Object))
+    {
+        return cJSON_TapeNone;
+    }
+
+    child = tape_value(tape, position) + 1;
+    if ((tape_tag(tape->words[child]) == ']') || (tape_tag(tape->words[child]) == '}'))
+    {
+        return cJSON_TapeNone;
+    }
+
+    return child;
+}
+
+CJSON_PUBLIC(size_t) cJSON_TapeNext(const cJSON_Tape *tape, size_t position)
+{
+    size_t next = 0;
+
+    if (!tape_can_access(tape, position))
+    {
+        return cJSON_TapeNone;
+    }
+
+    next = tape_skip(tape, tape_value(tape, position));
+    if ((next >= tape->length) || (tape_tag(tape->words[next]) == ']') || (tape_tag(tape->words[next]) == '}'))
+    {
+        return cJSON_TapeNone;
+    }
+
+    return next;
+}
+
+CJSON_PUBLIC(size_t) cJSON_TapeGetArrayItem(const cJSON_Tape *tape, size_t position, int index)
+{
+    size_t child = cJSON_TapeNone;
+
+    if (index < 0)
+    {
+        return cJSON_TapeNone;
+    }
+
+    child = cJSON_TapeChild(tape, position);
+    while ((child != cJSON_TapeNone) && (index > 0))
+    {
+        child = cJSON_TapeNext(tape, child);
+        index--;
+    }
+
+    return child;
+}
+
+static size_t tape_get_object_item(const cJSON_Tape * const tape, size_t position, const char * const name, const cJSON_bool case_sensitive)
+{
+    size_t member = cJSON_TapeNone;
+
+    if ((name == NULL) || (cJSON_TapeType(tape, position) != cJSON_Object))
+    {
+        return cJSON_TapeNone;
+    }
+
+    for (member = cJSON_TapeChild(tape, position); member != cJSON_TapeNone; member = cJSON_TapeNext(tape, member))
+    {
+        const unsigned char *member_name = tape->strings + tape_payload(tape->words[member]);
+        if (case_sensitive ? (strcmp(name, (const char*)member_name) == 0) : (case_insensitive_strcmp((const unsigned char*)name, member_name) == 0))
+        {
+            return member;
+        }
+    }
+
+    return cJSON_TapeNone;
+}
+
+CJSON_PUBLIC(size_t) cJSON_TapeGetObjectItem(const cJSON_Tape *tape, size_t position, const char *string)
+{
+    return tape_get_object_item(tape, position, string, false);
+}
+
+CJSON_PUBLIC(size_t) cJSON_TapeGetObjectItemCaseSensitive(const cJSON_Tape *tape, size_t position, const char *string)
+{
+    return tape_get_object_item(tape, position, string, true);
+}
+
+static cJSON *tape_to_tree(const cJSON_Tape * const tape, size_t position)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    cJSON *child = NULL;
+    cJSON *previous = NULL;
+    size_t member = 0;
+
+    if (item == NULL)
+    {
+        return NULL;
+    }
+
+    item->type = cJSON_TapeType(tape, position);
+    switch (item->type)
+    {
+        case cJSON_True:
+            item->valueint = 1;
+            break;
+
+        case cJSON_Number:
+            cJSON_SetNumberHelper(item, cJSON_TapeNumber(tape, position));
+            break;
+
+        case cJSON_String:
+            item->valuestring = (char*)cJSON_strdup((const unsigned char*)cJSON_TapeString(tape, position), &global_hooks);
+            if (item->valuestring == NULL)
+            {
+                goto fail;
+            }
+            break;
+
+        case cJSON_Array:
+        case cJSON_Object:
+            for (member = cJSON_TapeChild(tape, position); member != cJSON_TapeNone; member = cJSON_TapeNext(tape, member))
+            {
+                child = tape_to_tree(tape, member);
+                if (child == NULL)
+                {
+                    goto fail;
+                }
+
+                if (previous == NULL)
+                {
+                    item->child = child;
+                }
+                else
+                {
+                    previous->next = child;
+                    child->prev = previous;
+                }
+                previous = child;
+
+                if (item->type == cJSON_Object)
+                {
+                    child->string = (char*)cJSON_strdup((const unsigned char*)cJSON_TapeName(tape, member), &global_hooks);
+                    if (child->string == NULL)
+                    {
+                        goto fail;
+                    }
+                }
+            }
+            if (item->child != NULL)
+            {
+                item->child->prev = previous;
+            }
+            break;
+
+        default:
+            break;
     }
 
     return item;
 
 fail:
-    if (item != NULL)
-    {
-        cJSON_Delete(item);
-    }
-
-    if (value != NULL)
-    {
-        error local_error;
-        local_error.json = (const unsigned char*)value;
-        local_error.position = 0;
-
-        if (buffer.offset < buffer.length)
-        {
-            local_error.position = buffer.offset;
-        }
-        else if (buffer.length > 0)
-        {
-            local_error.position = buffer.length - 1;
-        }
-
-        if (return_parse_end != NULL)
-        {
-            *return_parse_end = (const char*)local_error.json + local_error.position;
-        }
-
-        global_error = local_error;
-    }
+    cJSON_Delete(item);
 
     return NULL;
 }
 
-/* Default options for cJSON_Parse */
-CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+CJSON_PUBLIC(cJSON *) cJSON_TapeToTree(const cJSON_Tape *tape, size_t position)
 {
-    return cJSON_ParseWithOpts(value, 0, 0);
-}
+    if (cJSON_TapeType(tape, position) == cJSON_Invalid)
+    {
+        return NULL;
+    }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
-{
-    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+    return tape_to_tree(tape, position);
 }
 
-#define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
-
 static unsigned char *print(const cJSON * const item, cJSON_bool format, const internal_hooks * const hooks)
 {
     static const size_t default_buffer_size = 256;
@@ -1311,7 +4283,7 @@ CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item)
 
 CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0 };
 
     if (prebuffer < 0)
     {
@@ -1342,7 +4314,7 @@ CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON
 
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0 };
 
     if ((length < 0) || (buffer == NULL))
     {
@@ -1359,6 +4331,46 @@ CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, cons
     return print_value(item, &p);
 }
 
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToSink(const cJSON *item, cJSON_Sink *sink, cJSON_bool format)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0, 0 }, 0 };
+    size_t length = 0;
+
+    if ((item == NULL) || (sink == NULL) || ((sink->buffer == NULL) && (sink->size != 0)) || (sink->length > sink->size))
+    {
+        return false;
+    }
+
+    length = sink->length;
+    if (sink->size == length)
+    {
+        /* ensure() needs a buffer with room for at least the terminator */
+        if ((sink->grow == NULL) || !sink->grow(sink, length + 256) || (sink->buffer == NULL) || (sink->size <= length))
+        {
+            sink->length = length;
+            return false;
+        }
+    }
+
+    p.buffer = sink->buffer;
+    p.length = sink->size;
+    p.offset = length;
+    p.format = format;
+    p.hooks = global_hooks;
+    p.sink = sink;
+
+    if (!print_value(item, &p))
+    {
+        /* drop what was printed */
+        sink->length = length;
+        return false;
+    }
+    update_offset(&p);
+    sink->length = p.offset;
+
+    return true;
+}
+
 /* Parser core - when encountering text, process appropriately. */
 static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
 {
@@ -1580,7 +4592,7 @@ success:
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        hooks_delete(head, &input_buffer->hooks);
     }
 
     return false;
@@ -1653,6 +4665,7 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
 {
     cJSON *head = NULL; /* linked list head */
     cJSON *current_item = NULL;
+    cJSON_bool parsed = false;
 
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
@@ -1722,6 +4735,11 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         /* swap valuestring and string, because we parsed the name */
         current_item->string = current_item->valuestring;
         current_item->valuestring = NULL;
+        if (input_buffer->in_situ)
+        {
+            /* the name points into the input */
+            current_item->type = cJSON_StringIsConst;
+        }
 
         if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
         {
@@ -1731,7 +4749,13 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         /* parse the value */
         input_buffer->offset++;
         buffer_skip_whitespace(input_buffer);
-        if (!parse_value(current_item, input_buffer))
+        parsed = parse_value(current_item, input_buffer);
+        if (input_buffer->in_situ)
+        {
+            /* parse_value sets the type */
+            current_item->type |= cJSON_StringIsConst;
+        }
+        if (!parsed)
         {
             goto fail; /* failed to parse value */
         }
@@ -1753,6 +4777,11 @@ success:
 
     item->type = cJSON_Object;
     item->child = head;
+    if (input_buffer->hooks.arena != NULL)
+    {
+        /* an index would be allocated outside of the arena and leak when it is reset */
+        item->index = INDEX_NEVER;
+    }
 
     input_buffer->offset++;
     return true;
@@ -1760,7 +4789,7 @@ success:
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        hooks_delete(head, &input_buffer->hooks);
     }
 
     return false;
@@ -1933,6 +4962,293 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
     return get_array_item(array, (size_t)index);
 }
 
+static void* cast_away_const(const void* string);
+
+static size_t hash_key(const unsigned char *key)
+{
+    size_t hash = 2166136261U; /* FNV-1a */
+    for (; *key != '\0'; key++)
+    {
+        hash = (hash ^ (size_t)tolower(*key)) * 16777619U;
+    }
+
+    return hash;
+}
+
+/* insert item, return false if the index is too full and must be rebuilt */
+static cJSON_bool index_insert(cJSON_Index * const index, cJSON * const item)
+{
+    size_t hash = 0;
+    size_t i = 0;
+
+    if ((index->count + 1) * 4 > (index->mask + 1) * 3)
+    {
+        return false;
+    }
+
+    hash = hash_key((const unsigned char*)item->string);
+    for (i = hash & index->mask; index->slots[i].item != NULL; i = (i + 1) & index->mask)
+    {
+    }
+    index->slots[i].hash = hash;
+    index->slots[i].item = item;
+    index->count++;
+
+    return true;
+}
+
+static void drop_index(cJSON * const object)
+{
+    if ((object->index != NULL) && (object->index != INDEX_NEVER))
+    {
+        if (object->index != INDEX_NONE)
+        {
+            global_hooks.deallocate(object->index);
+        }
+        object->index = NULL;
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_DropIndex(cJSON *object)
+{
+    if (object != NULL)
+    {
+        drop_index(object);
+    }
+}
+
+/* index the members of object */
+static void build_index(cJSON * const object)
+{
+    cJSON_Index *index = NULL;
+    cJSON *current_element = NULL;
+    size_t count = 0;
+    size_t slots = 4;
+
+    /* references share the members of another object, whose changes they would not see */
+    if ((object->index != NULL) || ((object->type & 0xFF) != cJSON_Object) || (object->type & cJSON_IsReference))
+    {
+        return;
+    }
+
+    for (current_element = object->child; current_element != NULL; current_element = current_element->next)
+    {
+        if (current_element->string == NULL)
+        {
+            /* lookups stop at unnamed members, a hash table can't reproduce that */
+            object->index = INDEX_NONE;
+            return;
+        }
+        count++;
+    }
+
+    while (slots < count * 3)
+    {
+        slots *= 2;
+    }
+    index = (cJSON_Index*)global_hooks.allocate(sizeof(cJSON_Index) + (slots - 1) * sizeof(index->slots[0]));
+    if (index == NULL)
+    {
+        return;
+    }
+    memset(index, '\0', sizeof(cJSON_Index) + (slots - 1) * sizeof(index->slots[0]));
+    index->mask = slots - 1;
+
+    for (current_element = object->child; current_element != NULL; current_element = current_element->next)
+    {
+        index_insert(index, current_element);
+    }
+    object->index = index;
+}
+
+static cJSON_bool has_index(const cJSON * const object)
+{
+    return (object->index != NULL) && (object->index != INDEX_NEVER) && (object->index != INDEX_NONE);
+}
+
+/* the index is too full or can no longer keep list order: index the current members again */
+static void rebuild_index(cJSON * const object)
+{
+    drop_index(object);
+    build_index(object);
+}
+
+/* slot of item, or mask + 1 if it is not in the index */
+static size_t index_find(const cJSON_Index * const index, const cJSON * const item, const size_t hash)
+{
+    size_t i = 0;
+
+    for (i = hash & index->mask; index->slots[i].item != NULL; i = (i + 1) & index->mask)
+    {
+        if (index->slots[i].item == item)
+        {
+            return i;
+        }
+    }
+
+    return index->mask + 1;
+}
+
+/* does any member hash like this key, i.e. could it be a duplicate of it */
+static cJSON_bool index_has_hash(const cJSON_Index * const index, const size_t hash)
+{
+    size_t i = 0;
+
+    for (i = hash & index->mask; index->slots[i].item != NULL; i = (i + 1) & index->mask)
+    {
+        if (index->slots[i].hash == hash)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Empty slot i, moving later members of its probe sequence back into the hole (no tombstones).
+ * Members with the same hash keep their relative order, so duplicates still resolve to the first one. */
+static void index_remove_slot(cJSON_Index * const index, size_t i)
+{
+    size_t j = i;
+    size_t home = 0;
+
+    for (j = (i + 1) & index->mask; index->slots[j].item != NULL; j = (j + 1) & index->mask)
+    {
+        home = index->slots[j].hash & index->mask;
+        /* the member at j may move to i unless its home slot lies cyclically in (i, j] */
+        if ((i <= j) ? ((home <= i) || (home > j)) : ((home <= i) && (home > j)))
+        {
+            index->slots[i] = index->slots[j];
+            i = j;
+        }
+    }
+    index->slots[i].item = NULL;
+    index->slots[i].hash = 0;
+    index->count--;
+}
+
+/* The member was appended to the list, keep the index in step */
+static void index_append(cJSON * const object, cJSON * const item)
+{
+    if (!has_index(object))
+    {
+        return;
+    }
+    if (item->string == NULL)
+    {
+        /* lookups stop at unnamed members, a hash table can't reproduce that */
+        drop_index(object);
+    }
+    else if (!index_insert(object->index, item))
+    {
+        /* grow the table */
+        rebuild_index(object);
+    }
+}
+
+/* The member was linked in before the end of the list. A probe sequence follows list order only
+ * when members are inserted in that order, so a member that may duplicate a key needs a rebuild. */
+static void index_insert_before(cJSON * const object, cJSON * const item)
+{
+    if (!has_index(object))
+    {
+        return;
+    }
+    if (item->string == NULL)
+    {
+        drop_index(object);
+    }
+    else if (index_has_hash(object->index, hash_key((const unsigned char*)item->string)) || !index_insert(object->index, item))
+    {
+        rebuild_index(object);
+    }
+}
+
+/* The member is being unlinked from the list */
+static void index_detach(cJSON * const object, const cJSON * const item)
+{
+    size_t i = 0;
+
+    if (!has_index(object))
+    {
+        return;
+    }
+    i = (item->string != NULL) ? index_find(object->index, item, hash_key((const unsigned char*)item->string)) : object->index->mask + 1;
+    if (i > object->index->mask)
+    {
+        /* not a member we know of: the list was edited by hand */
+        drop_index(object);
+        return;
+    }
+    index_remove_slot(object->index, i);
+}
+
+/* The member item was replaced by replacement at the same place in the list */
+static void index_replace(cJSON * const object, const cJSON * const item, cJSON * const replacement)
+{
+    size_t hash = 0;
+    size_t i = 0;
+
+    if (!has_index(object))
+    {
+        return;
+    }
+    if ((item->string == NULL) || (replacement->string == NULL))
+    {
+        drop_index(object);
+        return;
+    }
+    hash = hash_key((const unsigned char*)item->string);
+    i = index_find(object->index, item, hash);
+    if (i > object->index->mask)
+    {
+        drop_index(object);
+        return;
+    }
+    if (hash_key((const unsigned char*)replacement->string) == hash)
+    {
+        /* same probe sequence and the same place in it */
+        object->index->slots[i].item = replacement;
+        return;
+    }
+    index_remove_slot(object->index, i);
+    index_insert_before(object, replacement);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IndexObject(cJSON *object)
+{
+    if (object == NULL)
+    {
+        return false;
+    }
+
+    /* rebuild from the current members, which may have been edited by hand */
+    rebuild_index(object);
+
+    return has_index(object);
+}
+
+static cJSON *index_lookup(const cJSON_Index * const index, const char * const name, const cJSON_bool case_sensitive)
+{
+    size_t hash = hash_key((const unsigned char*)name);
+    size_t i = 0;
+
+    for (i = hash & index->mask; index->slots[i].item != NULL; i = (i + 1) & index->mask)
+    {
+        cJSON *item = index->slots[i].item;
+        if (index->slots[i].hash != hash)
+        {
+            continue;
+        }
+        if (case_sensitive ? (strcmp(name, item->string) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)item->string) == 0))
+        {
+            return item;
+        }
+    }
+
+    return NULL;
+}
+
 static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
 {
     cJSON *current_element = NULL;
@@ -1942,6 +5258,11 @@ static cJSON *get_object_item(const cJSON * const object, const char * const nam
         return NULL;
     }
 
+    if (has_index(object))
+    {
+        return index_lookup(object->index, name, case_sensitive);
+    }
+
     current_element = object->child;
     if (case_sensitive)
     {
@@ -2004,6 +5325,7 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
 
     memcpy(reference, item, sizeof(cJSON));
     reference->string = NULL;
+    reference->index = NULL;
     reference->type |= cJSON_IsReference;
     reference->next = reference->prev = NULL;
     return reference;
@@ -2038,6 +5360,7 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
             array->child->prev = item;
         }
     }
+    index_append(array, item);
 
     return true;
 }
@@ -2272,6 +5595,7 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
     /* make sure the detached item doesn't point anywhere anymore */
     item->prev = NULL;
     item->next = NULL;
+    index_detach(parent, item);
 
     return item;
 }
@@ -2347,6 +5671,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
     {
         newitem->prev->next = newitem;
     }
+    index_insert_before(array, newitem);
     return true;
 }
 
@@ -2394,6 +5719,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
 
     item->next = NULL;
     item->prev = NULL;
+    index_replace(parent, item, replacement);
     cJSON_Delete(item);
 
     return true;
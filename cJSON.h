@@ -120,6 +120,9 @@ typedef struct cJSON
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+
+    /* Private: key index of the object, built by cJSON_IndexObject */
+    struct cJSON_Index *index;
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -131,6 +134,53 @@ typedef struct cJSON_Hooks
 
 typedef int cJSON_bool;
 
+/* Caller-provided memory for cJSON_ParseInArena. All items and strings of a document parsed into
+ * an arena are carved from its buffer, so the whole document is released at once by resetting it. */
+typedef struct cJSON_Arena
+{
+    unsigned char *buffer;
+    size_t size;
+    size_t used;
+    size_t last; /* offset of the most recent allocation, it can be given back */
+} cJSON_Arena;
+
+/* A growable buffer owned by the caller, for cJSON_PrintToSink. grow has to make buffer at least size bytes
+ * large, keeping its first length bytes, and update buffer and size; it returns false when it can't. grow may be
+ * NULL for a fixed buffer. */
+typedef struct cJSON_Sink
+{
+    unsigned char *buffer;
+    size_t size;
+    size_t length; /* bytes in use, printing appends after them */
+    cJSON_bool (*grow)(struct cJSON_Sink *sink, size_t size);
+    void *user_data;
+} cJSON_Sink;
+
+/* Incremental parser, see cJSON_CreateStream. */
+typedef struct cJSON_Stream cJSON_Stream;
+
+/* Callbacks for a cJSON_Stream that reports values instead of building a tree. value is called for every value,
+ * with the member name as key inside objects and NULL otherwise. For an array or object, item only carries the type;
+ * its members follow and then end is called. item and key are only valid during the call. Returning false stops
+ * parsing with cJSON_StreamError. */
+typedef struct cJSON_StreamHandler
+{
+    cJSON_bool (*value)(void *user_data, const char *key, const cJSON *item);
+    cJSON_bool (*end)(void *user_data);
+    void *user_data;
+} cJSON_StreamHandler;
+
+/* Results of cJSON_StreamFeed and cJSON_StreamFinish */
+#define cJSON_StreamError (-1)
+#define cJSON_StreamMore (0)
+#define cJSON_StreamDone (1)
+
+/* Compact read-only document, see cJSON_ParseTape. */
+typedef struct cJSON_Tape cJSON_Tape;
+
+/* The position that the cJSON_Tape navigation functions return for "no such value" */
+#define cJSON_TapeNone ((size_t)-1)
+
 /* Limits how deeply nested arrays/objects can be before cJSON rejects to parse them.
  * This is to prevent stack overflows. */
 #ifndef CJSON_NESTING_LIMIT
@@ -158,6 +208,61 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
 
+/* Arena parsing: no malloc/free per item and string. Parsing fails like an allocation failure when the arena is full.
+ * Never cJSON_Delete a document parsed into an arena, nor modify it in ways that free or reallocate its items or strings:
+ * release it with cJSON_ResetArena, which also makes the arena reusable for the next document. */
+CJSON_PUBLIC(void) cJSON_InitArena(cJSON_Arena *arena, void *buffer, size_t size);
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena);
+CJSON_PUBLIC(cJSON *) cJSON_ParseInArena(cJSON_Arena *arena, const char *value, size_t buffer_length);
+CJSON_PUBLIC(cJSON *) cJSON_ParseInArenaOpts(cJSON_Arena *arena, const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+
+/* In-situ parsing: strings and names are unescaped inside value itself, and valuestring/string point there, so only
+ * the items are allocated. value must be writable and outlive the tree; it is modified even when parsing fails.
+ * Strings are flagged cJSON_IsReference and names cJSON_StringIsConst, so cJSON_Delete leaves them alone (and
+ * cJSON_SetValuestring refuses to change them, as for references). */
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value, size_t buffer_length);
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSituOpts(char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+
+/* Incremental parsing of a document that arrives in pieces (WebSocket fragments, chunked HTTP bodies). Chunks may
+ * split the text anywhere. Between calls the parser keeps only the open arrays/objects and the string or number being
+ * read, so its memory depends on the nesting depth and the longest string, not on the document size.
+ * With handler == NULL it builds the same tree as cJSON_Parse, take it with cJSON_StreamTakeResult. Only whitespace
+ * may follow the document. */
+CJSON_PUBLIC(cJSON_Stream *) cJSON_CreateStream(const cJSON_StreamHandler *handler);
+/* Returns cJSON_StreamDone once the document is complete, cJSON_StreamMore while it is not, or cJSON_StreamError. */
+CJSON_PUBLIC(int) cJSON_StreamFeed(cJSON_Stream *stream, const char *chunk, size_t length);
+/* Call at the end of the input: completes a number at the top level, and fails if the document is incomplete. */
+CJSON_PUBLIC(int) cJSON_StreamFinish(cJSON_Stream *stream);
+/* The parsed tree once cJSON_StreamDone was returned, the caller has to cJSON_Delete it. */
+CJSON_PUBLIC(cJSON *) cJSON_StreamTakeResult(cJSON_Stream *stream);
+/* Bytes consumed so far, after an error the position of the error. */
+CJSON_PUBLIC(size_t) cJSON_StreamOffset(const cJSON_Stream *stream);
+CJSON_PUBLIC(void) cJSON_DeleteStream(cJSON_Stream *stream);
+
+/* Tape parsing, for large documents that are read but not modified: the whole document is one array of tagged
+ * 64 bit words plus its strings, two allocations in total and about 8 bytes per value instead of a cJSON item each.
+ * Values are addressed by their position on the tape, the root is at position 0. Accepts exactly what cJSON_Parse
+ * accepts, and the input isn't needed afterwards. */
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTape(const char *value, size_t buffer_length);
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTapeOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+CJSON_PUBLIC(void) cJSON_DeleteTape(cJSON_Tape *tape);
+/* The cJSON type (cJSON_False ... cJSON_Object) of the value at position, cJSON_Invalid for an invalid position. */
+CJSON_PUBLIC(int) cJSON_TapeType(const cJSON_Tape *tape, size_t position);
+CJSON_PUBLIC(double) cJSON_TapeNumber(const cJSON_Tape *tape, size_t position);
+/* Strings live as long as the tape. */
+CJSON_PUBLIC(const char *) cJSON_TapeString(const cJSON_Tape *tape, size_t position);
+/* The name of an object member, NULL for array elements and the root. */
+CJSON_PUBLIC(const char *) cJSON_TapeName(const cJSON_Tape *tape, size_t position);
+CJSON_PUBLIC(int) cJSON_TapeSize(const cJSON_Tape *tape, size_t position);
+/* Walking arrays/objects: the first element/member and the one after it, or cJSON_TapeNone. */
+CJSON_PUBLIC(size_t) cJSON_TapeChild(const cJSON_Tape *tape, size_t position);
+CJSON_PUBLIC(size_t) cJSON_TapeNext(const cJSON_Tape *tape, size_t position);
+CJSON_PUBLIC(size_t) cJSON_TapeGetArrayItem(const cJSON_Tape *tape, size_t position, int index);
+CJSON_PUBLIC(size_t) cJSON_TapeGetObjectItem(const cJSON_Tape *tape, size_t position, const char *string);
+CJSON_PUBLIC(size_t) cJSON_TapeGetObjectItemCaseSensitive(const cJSON_Tape *tape, size_t position, const char *string);
+/* Copy the value at position into a cJSON tree to modify it, the caller has to cJSON_Delete it. */
+CJSON_PUBLIC(cJSON *) cJSON_TapeToTree(const cJSON_Tape *tape, size_t position);
+
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. */
@@ -167,6 +272,11 @@ CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON
 /* Render a cJSON entity to text using a buffer already allocated in memory with given length. Returns 1 on success and 0 on failure. */
 /* NOTE: cJSON is not always 100% accurate in estimating how much memory it will use, so to be safe allocate 5 bytes more than you actually need */
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format);
+/* Render a cJSON entity straight into a caller-owned buffer, e.g. a connection's send buffer, without an intermediate
+ * allocation or copy. The text is appended at sink->length and sink->length is advanced past it; a '\0' follows that
+ * is not counted. On failure sink->length is left as it was. Like cJSON_PrintPreallocated, a fixed buffer needs a
+ * few bytes more than the text. */
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToSink(const cJSON *item, cJSON_Sink *sink, cJSON_bool format);
 /* Delete a cJSON entity and all subentities. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item);
 
@@ -178,6 +288,15 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string);
+/* Give a large object a hash index, so that the lookups above become O(1) instead of walking its members.
+ * Lookups never build an index themselves: they don't write to the tree, so concurrent lookups on a shared
+ * tree are safe as long as nothing modifies it. The cJSON functions that add, insert, detach, delete and
+ * replace members update the index in place, growing it as needed; only adding an unnamed member discards it.
+ * Call cJSON_IndexObject again, or cJSON_DropIndex, after relinking the members of an indexed object or
+ * renaming them by hand, otherwise lookups may return stale or freed items.
+ * Returns false if the object can't be indexed (not an object, a reference, arena-allocated or with unnamed members). */
+CJSON_PUBLIC(cJSON_bool) cJSON_IndexObject(cJSON *object);
+CJSON_PUBLIC(void) cJSON_DropIndex(cJSON *object);
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
 CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void);
 
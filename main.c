@@ -1,12 +1,21 @@
+#define _GNU_SOURCE  // struct ucred, pour SO_PEERCRED
 #include "mongoose.h"
 #include "cJSON.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
+#include <ctype.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <pwd.h>
 #include <time.h>
 #include <limits.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <sys/wait.h>
+#include <glob.h>
+#include <poll.h>
 
 #ifndef PATH_MAX
 #define PATH_MAX 4096
@@ -15,6 +24,20 @@
 // Configuration
 #define WS_URL "wss://wallchange.codeky.fr" 
 
+// Numéro de version, à augmenter à chaque binaire publié : une mise à jour
+// vers un numéro inférieur ou égal est refusée
+#ifndef WALLCHANGE_VERSION
+#define WALLCHANGE_VERSION 1
+#endif
+
+// Clé publique ECDSA P-256 qui signe les binaires de mise à jour : X puis Y,
+// 128 caractères hexadécimaux. Vide, le client se met à jour par git et make.
+// Avec une clé, il n'accepte plus que des binaires signés, sauf si
+// WALLCHANGE_UPDATE_FROM_SOURCE=1 est défini dans son environnement
+#ifndef UPDATE_PUBKEY
+#define UPDATE_PUBKEY ""
+#endif
+
 
 // Variables globales
 static int interrupted = 0;
@@ -55,140 +78,459 @@ void set_wallpaper(const char *filepath) {
     if (system(command) != 0) fprintf(stderr, "Erreur lors de l'exécution de la commande (dark mode)\n");
 }
 
-// Fonction de mise à jour automatique
-void perform_update() {
-    printf("Mise à jour demandée...\n");
-    
-    // 1. Déterminer le dossier source
-    char source_dir[PATH_MAX];
-    const char *home = getenv("HOME");
-    int source_found = 0;
+// Champs du protocole lus dans un message
+struct ws_fields {
+    char command[32];
+    char url[2048];
+    long ref;          // réponse "sent" : numéro de la requête relayée
+    int status;        // ... et son code HTTP
+    char error[256];
+    long size;         // "image_start" : taille annoncée
+    char sha256[65];   // "image_end" : somme des octets reçus
+};
 
-    if (home) {
-        snprintf(source_dir, sizeof(source_dir), "%s/.wallchange_source", home);
-        if (access(source_dir, F_OK) == 0) {
-            source_found = 1;
+// Copie une valeur chaîne JSON (guillemets compris) dans dst, sans allocation
+static int copy_json_string(struct mg_str val, char *dst, size_t size) {
+    if (val.len < 2 || val.buf[0] != '"') return 0;
+    if (!mg_json_unescape(mg_str_n(val.buf + 1, val.len - 2), dst, size)) {
+        dst[0] = '\0';
+        return 0;
+    }
+    return 1;
+}
+
+// Extraction des clés connues en une seule passe, directement depuis la
+// trame : pas d'arbre cJSON, aucune allocation sur le tas par message.
+// Retourne 0 si le message n'est pas un objet JSON valide
+static int parse_fields(const char *msg, size_t len, struct ws_fields *f) {
+    struct mg_str json, key, val;
+    size_t ofs = 0, last = 0;
+
+    f->command[0] = f->url[0] = f->error[0] = '\0';
+    f->ref = f->size = 0;
+    f->status = 0;
+    f->sha256[0] = '\0';
+    while (len > 0 && isspace((unsigned char) msg[0])) msg++, len--;
+    while (len > 0 && isspace((unsigned char) msg[len - 1])) len--;
+    json = mg_str_n(msg, len);
+    while ((ofs = mg_json_next(json, ofs, &key, &val)) > 0) {
+        if (mg_strcmp(key, mg_str("\"command\"")) == 0) {
+            copy_json_string(val, f->command, sizeof(f->command));
+        } else if (mg_strcmp(key, mg_str("\"url\"")) == 0) {
+            if (!copy_json_string(val, f->url, sizeof(f->url))) {
+                printf("Erreur: URL invalide ou trop longue.\n");
+            }
+        } else if (mg_strcmp(key, mg_str("\"ref\"")) == 0) {
+            f->ref = mg_json_get_long(val, "$", 0);
+        } else if (mg_strcmp(key, mg_str("\"status\"")) == 0) {
+            f->status = (int) mg_json_get_long(val, "$", 0);
+        } else if (mg_strcmp(key, mg_str("\"error\"")) == 0) {
+            copy_json_string(val, f->error, sizeof(f->error));
+        } else if (mg_strcmp(key, mg_str("\"size\"")) == 0) {
+            f->size = mg_json_get_long(val, "$", 0);
+        } else if (mg_strcmp(key, mg_str("\"sha256\"")) == 0) {
+            copy_json_string(val, f->sha256, sizeof(f->sha256));
         }
+        last = ofs;
     }
 
-    // Fallback: dossier courant si Makefile présent
-    if (!source_found && access("Makefile", F_OK) == 0) {
-        if (getcwd(source_dir, sizeof(source_dir)) != NULL) {
-            source_found = 1;
-            printf("Utilisation du dossier courant comme source: %s\n", source_dir);
+    // Un objet complet se termine sur '}' juste après la dernière valeur
+    if (last == 0) {
+        last = 1;
+        while (last < len && isspace((unsigned char) msg[last])) last++;
+    }
+    return len > 1 && msg[0] == '{' && last == len - 1 && msg[last] == '}';
+}
+
+// Socket de contrôle du client : `wallchange send` y confie les envois qui
+// ne demandent pas d'upload, relayés sur la connexion WebSocket déjà
+// ouverte, sans DNS ni poignée de main TLS. Une ligne JSON par requête :
+//   -> {"ref":1,"id":"alice","url":"https://..."}  (ou "hash":"<sha256>")
+//   <- {"ref":1,"status":200,"error":""}
+// Le serveur reçoit {"command":"send","id":...,"url"|"hash":...,"ref":N}
+// et répond {"command":"sent","ref":N,"status":200,"error":"..."}
+#define RELAY_MAX 256
+// Sans réponse du serveur dans ce délai, il ne connaît sans doute pas
+// l'envoi par WebSocket : les requêtes suivantes sont refusées tout de
+// suite et le client passe par HTTP
+#define RELAY_TIMEOUT_MS 3000
+
+// Une requête relayée au serveur, en attente de sa réponse
+struct relay {
+    unsigned long ref;      // numéro envoyé au serveur, 0 si libre
+    unsigned long conn_id;  // connexion locale qui attend la réponse
+    long client_ref;        // numéro choisi par le client
+    uint64_t deadline;
+};
+
+enum { RELAY_UNKNOWN, RELAY_YES, RELAY_NO };
+
+static struct relay relays[RELAY_MAX];
+static unsigned long relay_next_ref = 1;
+static int relay_support = RELAY_UNKNOWN;  // pour la connexion WebSocket en cours
+
+// $XDG_RUNTIME_DIR/wallchange.sock, ou /tmp/wallchange-<uid>/wallchange.sock.
+// Le dossier doit appartenir à l'utilisateur et lui être réservé (0700),
+// sinon un autre utilisateur pourrait y placer son socket avant le client.
+// create crée le dossier de /tmp. Retourne 0 si le dossier n'est pas sûr
+static int control_socket_path(char *buf, size_t size, int create) {
+    const char *dir = getenv("XDG_RUNTIME_DIR");
+    char tmp[64];
+    struct stat st;
+
+    if (dir == NULL || dir[0] == '\0') {
+        snprintf(tmp, sizeof(tmp), "/tmp/wallchange-%lu", (unsigned long) getuid());
+        dir = tmp;
+        if (create) mkdir(dir, 0700);
+    }
+    snprintf(buf, size, "%s/wallchange.sock", dir);
+    return lstat(dir, &st) == 0 && S_ISDIR(st.st_mode) && st.st_uid == getuid() &&
+           (st.st_mode & 077) == 0;
+}
+
+// Le processus à l'autre bout du socket fd appartient-il à l'utilisateur ?
+static int peer_is_self(int fd) {
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+    return getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0 && cred.uid == getuid();
+}
+
+// Lit la chaîne JSON à path dans dst
+static int json_string_at(struct mg_str json, const char *path, char *dst, size_t size) {
+    int len = 0, ofs = mg_json_get(json, path, &len);
+    dst[0] = '\0';
+    return ofs >= 0 && copy_json_string(mg_str_n(json.buf + ofs, (size_t) len), dst, size);
+}
+
+static void control_reply(struct mg_connection *c, long ref, int status, const char *error) {
+    mg_printf(c, "{%m:%ld,%m:%d,%m:%m}\n", MG_ESC("ref"), ref, MG_ESC("status"), status,
+              MG_ESC("error"), MG_ESC(error));
+}
+
+// Répond au client local qui attend la requête relayée r, s'il est encore là
+static void relay_done(struct relay *r, int status, const char *error) {
+    struct mg_connection *c;
+    for (c = mgr.conns; c != NULL; c = c->next) {
+        if (c->id == r->conn_id) control_reply(c, r->client_ref, status, error);
+    }
+    r->ref = 0;
+}
+
+// Réponse du serveur à une requête relayée
+static void relay_answer(long ref, int status, const char *error) {
+    size_t i;
+    relay_support = RELAY_YES;
+    for (i = 0; i < RELAY_MAX; i++) {
+        if (relays[i].ref != 0 && relays[i].ref == (unsigned long) ref) relay_done(&relays[i], status, error);
+    }
+}
+
+// Requêtes sans réponse : délai dépassé, ou connexion WebSocket perdue
+static void relay_expire(int disconnected) {
+    uint64_t now = mg_millis();
+    size_t i;
+    for (i = 0; i < RELAY_MAX; i++) {
+        if (relays[i].ref == 0) continue;
+        if (disconnected) {
+            relay_done(&relays[i], 503, "connexion au serveur perdue");
+        } else if (now > relays[i].deadline) {
+            if (relay_support == RELAY_UNKNOWN) relay_support = RELAY_NO;
+            relay_done(&relays[i], 504, "pas de réponse du serveur");
         }
     }
+}
 
-    if (!source_found) {
-        fprintf(stderr, "Erreur: Impossible de localiser le dossier source (.wallchange_source ou dossier courant).\n");
+// Une ligne reçue sur le socket de contrôle
+static void control_request(struct mg_connection *c, const char *line, size_t len) {
+    struct mg_str json = mg_str_n(line, len);
+    char id[256], url[2048], hash[65];
+    long ref = mg_json_get_long(json, "$.ref", 0);
+    struct relay *r = NULL;
+    size_t i;
+
+    json_string_at(json, "$.url", url, sizeof(url));
+    json_string_at(json, "$.hash", hash, sizeof(hash));
+    if (!json_string_at(json, "$.id", id, sizeof(id)) || (url[0] == '\0' && hash[0] == '\0')) {
+        control_reply(c, ref, 400, "requête invalide");
+        return;
+    }
+    if (ws_conn == NULL) {
+        control_reply(c, ref, 503, "pas de connexion au serveur");
+        return;
+    }
+    if (relay_support == RELAY_NO) {
+        control_reply(c, ref, 501, "envoi par WebSocket non pris en charge par le serveur");
+        return;
+    }
+    for (i = 0; i < RELAY_MAX && r == NULL; i++) {
+        if (relays[i].ref == 0) r = &relays[i];
+    }
+    if (r == NULL) {
+        control_reply(c, ref, 503, "trop de requêtes en attente");
         return;
     }
 
-    // 2. Sauvegarder le chemin de l'exécutable actuel
-    char current_exe[PATH_MAX];
-    ssize_t len = readlink("/proc/self/exe", current_exe, sizeof(current_exe) - 1);
-    if (len == -1) {
-        perror("readlink failed");
+    r->ref = relay_next_ref++;
+    r->conn_id = c->id;
+    r->client_ref = ref;
+    r->deadline = mg_millis() + RELAY_TIMEOUT_MS;
+    mg_ws_printf(ws_conn, WEBSOCKET_OP_TEXT, "{%m:%m,%m:%m,%m:%m,%m:%lu}", MG_ESC("command"), MG_ESC("send"),
+                 MG_ESC("id"), MG_ESC(id), MG_ESC(url[0] != '\0' ? "url" : "hash"),
+                 MG_ESC(url[0] != '\0' ? url : hash), MG_ESC("ref"), r->ref);
+}
+
+// Callback du socket de contrôle
+static void control_fn(struct mg_connection *c, int ev, void *ev_data) {
+    (void) ev_data;
+    if (ev == MG_EV_ACCEPT) {
+        if (!peer_is_self((int) (size_t) c->fd)) {
+            printf("Connexion au socket de contrôle d'un autre utilisateur refusée.\n");
+            c->is_closing = 1;
+        }
+    } else if (ev == MG_EV_READ && !c->is_closing) {
+        char *nl;
+        while ((nl = memchr(c->recv.buf, '\n', c->recv.len)) != NULL) {
+            size_t len = (size_t) (nl - (char *) c->recv.buf);
+            control_request(c, (char *) c->recv.buf, len);
+            mg_iobuf_del(&c->recv, 0, len + 1);
+        }
+        // Ligne démesurée : ce n'est pas `wallchange send`
+        if (c->recv.len > 8192) c->is_closing = 1;
+    }
+}
+
+// Ouvre le socket de contrôle, sauf si un autre client l'écoute déjà
+static void control_listen(void) {
+    struct sockaddr_un sun;
+    char path[sizeof(sun.sun_path)], url[sizeof(path) + 8];
+    int fd;
+
+    if (!control_socket_path(path, sizeof(path), 1)) {
+        printf("Erreur: le dossier de %s n'est pas réservé à l'utilisateur, socket de contrôle désactivé.\n", path);
         return;
     }
-    current_exe[len] = '\0';
+    memset(&sun, 0, sizeof(sun));
+    sun.sun_family = AF_UNIX;
+    snprintf(sun.sun_path, sizeof(sun.sun_path), "%s", path);
+    if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) >= 0) {
+        int alive = connect(fd, (struct sockaddr *) &sun, sizeof(sun)) == 0;
+        int self = alive && peer_is_self(fd);
+        close(fd);
+        if (self) {
+            printf("Un autre client écoute déjà sur %s.\n", path);
+            return;
+        }
+        if (alive) {
+            printf("Erreur: %s est tenu par un autre utilisateur, socket de contrôle désactivé.\n", path);
+            return;
+        }
+    }
 
-    // 3. Se déplacer dans le dossier source
-    printf("Changement de répertoire vers %s\n", source_dir);
-    if (chdir(source_dir) != 0) {
-        perror("chdir failed");
+    // Fichier laissé par un client arrêté
+    unlink(path);
+    snprintf(url, sizeof(url), "unix://%s", path);
+    if (mg_listen(&mgr, url, control_fn, NULL) == NULL) {
+        printf("Erreur: impossible d'écouter sur %s.\n", path);
         return;
     }
-    
-    // 4. Git pull
-    printf("Exécution de git pull...\n");
-    if (system("git pull") != 0) {
-        printf("Attention: git pull a échoué ou n'est pas nécessaire.\n");
+    // Seul l'utilisateur peut envoyer en son nom
+    chmod(path, 0600);
+}
+
+// Image poussée par le serveur sur la connexion WebSocket, sans second
+// téléchargement :
+//   {"command":"image_start","size":N}
+//   des messages binaires, de préférence complets et de WS_IMAGE_CHUNK
+//   octets au plus
+//   {"command":"image_end","sha256":"<hex>"}
+// Un message plus long n'est pas gardé en mémoire : mongoose l'écrit dans
+// un fichier au fil de l'arrivée (mg_recv_limits) et le client le reçoit
+// en MG_EV_WS_FILE
+#define WS_IMAGE_CHUNK (64 * 1024)
+// Plafond de c->recv pour la connexion WebSocket : les gros messages
+// passent par le disque, le reste est court
+#define WS_RECV_MAX (1024 * 1024)
+
+// Image en cours de réception
+static struct {
+    int fd;                // fichier temporaire, -1 sans réception en cours
+    char path[PATH_MAX];
+    size_t size;           // taille annoncée
+    size_t received;
+    mg_sha256_ctx sha;
+} image_rx = {-1, "", 0, 0, {{0}, 0, 0, {0}}};
+
+static void image_abort(const char *why) {
+    if (image_rx.fd < 0) return;
+    printf("Réception de l'image abandonnée : %s.\n", why);
+    close(image_rx.fd);
+    unlink(image_rx.path);
+    image_rx.fd = -1;
+}
+
+static void image_start(long size) {
+    char *username = get_username();
+
+    image_abort("une autre image arrive");
+    if (size <= 0) {
+        printf("Erreur: taille d'image invalide.\n");
+        free(username);
+        return;
     }
-    
-    // 5. Recompile
-    printf("Recompilation...\n");
-    if (system("make re") != 0) {
-        printf("Erreur lors de la compilation.\n");
+    // Même dossier que l'image finale : le renommage final est atomique
+    snprintf(image_rx.path, sizeof(image_rx.path), "/home/%s/Pictures/.wallpaper_XXXXXX", username);
+    free(username);
+    if ((image_rx.fd = mkstemp(image_rx.path)) < 0) {
+        perror("mkstemp");
         return;
     }
-    
-    // 6. Copier le nouveau binaire si nécessaire
-    char new_binary[PATH_MAX + 16];
-    snprintf(new_binary, sizeof(new_binary), "%s/wallchange", source_dir);
-    
-    // On compare les chemins
-    char *real_new = realpath(new_binary, NULL);
-    char *real_current = realpath(current_exe, NULL);
+    image_rx.size = (size_t) size;
+    image_rx.received = 0;
+    mg_sha256_init(&image_rx.sha);
+    printf("Réception d'une image de %.1f Mo...\n", (double) size / 1e6);
+}
 
-    if (real_new && real_current && strcmp(real_new, real_current) != 0) {
-        printf("Mise à jour du binaire installé: %s -> %s\n", new_binary, current_exe);
-        
-        // Suppression de l'ancien pour éviter "Text file busy"
-        unlink(current_exe);
-        
-        size_t cmd_len = strlen(new_binary) + strlen(current_exe) + 64;
-        char *cp_cmd = malloc(cmd_len);
-        if (cp_cmd) {
-            snprintf(cp_cmd, cmd_len, "cp '%s' '%s'", new_binary, current_exe);
-            if (system(cp_cmd) != 0) {
-                fprintf(stderr, "Erreur lors de la copie du binaire.\n");
-                free(cp_cmd);
-                if (real_new) free(real_new);
-                if (real_current) free(real_current);
-                return;
-            }
-            free(cp_cmd);
+static int write_all(int fd, const void *buf, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = write(fd, (const char *) buf + done, len - done);
+        if (n <= 0) return 0;
+        done += (size_t) n;
+    }
+    return 1;
+}
+
+// Un bloc de l'image, écrit tout de suite
+static void image_chunk(const char *data, size_t len) {
+    if (image_rx.fd < 0) {
+        printf("Message binaire inattendu ignoré.\n");
+        return;
+    }
+    if (image_rx.received + len > image_rx.size) {
+        image_abort("plus d'octets qu'annoncé");
+        return;
+    }
+    if (!write_all(image_rx.fd, data, len)) {
+        image_abort("écriture impossible");
+        return;
+    }
+    mg_sha256_update(&image_rx.sha, (const unsigned char *) data, len);
+    image_rx.received += len;
+}
+
+// Un bloc trop gros pour la mémoire, déjà sur le disque. L'image entière
+// en un seul message prend directement la place du fichier temporaire
+static void image_file(const char *path, size_t size) {
+    unsigned char buf[WS_IMAGE_CHUNK];
+    int fd, whole;
+    ssize_t n;
+
+    if (image_rx.fd < 0) {
+        printf("Message binaire inattendu ignoré.\n");
+        return;
+    }
+    if (image_rx.received + size > image_rx.size) {
+        image_abort("plus d'octets qu'annoncé");
+        return;
+    }
+    if ((fd = open(path, O_RDONLY)) < 0) {
+        image_abort("lecture impossible");
+        return;
+    }
+    whole = image_rx.received == 0 && size == image_rx.size;
+    while ((n = read(fd, buf, sizeof(buf))) > 0) {
+        mg_sha256_update(&image_rx.sha, buf, (size_t) n);
+        if (!whole && !write_all(image_rx.fd, buf, (size_t) n)) {
+            close(fd);
+            image_abort("écriture impossible");
+            return;
         }
-    } else {
-        printf("Le binaire s'exécute déjà depuis la source ou chemins identiques.\n");
     }
-    
-    if (real_new) free(real_new);
-    if (real_current) free(real_current);
-    
-    // 7. Restart
-    printf("Redémarrage du client...\n");
-    
-    char *args[] = {current_exe, NULL};
-    execv(current_exe, args);
-    
-    // Si execv échoue
-    perror("execv failed");
+    close(fd);
+    if (whole && rename(path, image_rx.path) != 0) {
+        image_abort("renommage impossible");
+        return;
+    }
+    image_rx.received += size;
+}
+
+static void image_end(const char *expected) {
+    unsigned char digest[32];
+    char hex[65], filepath[512];
+    char *username;
+    int i;
+
+    if (image_rx.fd < 0) return;
+    mg_sha256_final(digest, &image_rx.sha);
+    for (i = 0; i < 32; i++) snprintf(hex + i * 2, 3, "%02x", digest[i]);
+    if (image_rx.received != image_rx.size) {
+        image_abort("image incomplète");
+        return;
+    }
+    if (strcasecmp(hex, expected) != 0) {
+        image_abort("somme SHA-256 différente");
+        return;
+    }
+    close(image_rx.fd);
+    image_rx.fd = -1;
+
+    username = get_username();
+    snprintf(filepath, sizeof(filepath), "/home/%s/Pictures/wallpaper_%ld.jpg", username, (long) time(NULL));
+    free(username);
+    if (rename(image_rx.path, filepath) != 0) {
+        perror("rename");
+        unlink(image_rx.path);
+        return;
+    }
+    printf("Image reçue (%.1f Mo).\n", (double) image_rx.received / 1e6);
+    set_wallpaper(filepath);
 }
 
+// Mise à jour du client, définie avec les fonctions HTTP plus bas
+void perform_update();
+
 // Traitement du message reçu
 void handle_message(const char *msg, size_t len) {
+    struct ws_fields f;
+
     printf("Message reçu: %.*s\n", (int)len, msg);
 
-    cJSON *json = cJSON_ParseWithLength(msg, len);
-    if (json == NULL) {
+    if (!parse_fields(msg, len, &f)) {
         printf("Erreur: JSON invalide.\n");
         return;
     }
 
+    // Réponse à un envoi relayé depuis le socket de contrôle
+    if (strcmp(f.command, "sent") == 0) {
+        relay_answer(f.ref, f.status, f.error);
+        return;
+    }
+
+    if (strcmp(f.command, "image_start") == 0) {
+        image_start(f.size);
+        return;
+    }
+    if (strcmp(f.command, "image_end") == 0) {
+        image_end(f.sha256);
+        return;
+    }
+
     // Vérification de la commande de mise à jour
-    cJSON *command_item = cJSON_GetObjectItemCaseSensitive(json, "command");
-    if (cJSON_IsString(command_item) && (command_item->valuestring != NULL)) {
-        if (strcmp(command_item->valuestring, "update") == 0) {
-            printf("Commande de mise à jour reçue.\n");
-            cJSON_Delete(json);
-            perform_update();
-            return;
-        }
+    if (strcmp(f.command, "update") == 0) {
+        printf("Commande de mise à jour reçue.\n");
+        perform_update();
+        return;
     }
 
-    cJSON *url_item = cJSON_GetObjectItemCaseSensitive(json, "url");
-    if (cJSON_IsString(url_item) && (url_item->valuestring != NULL)) {
-        char *url = url_item->valuestring;
-        printf("URL trouvée: %s\n", url);
+    if (f.url[0] != '\0') {
+        printf("URL trouvée: %s\n", f.url);
 
         char *username = get_username();
         char filepath[512];
         time_t t = time(NULL);
         snprintf(filepath, sizeof(filepath), "/home/%s/Pictures/wallpaper_%ld.jpg", username, t);
         
-        if (download_image(url, filepath)) {
+        if (download_image(f.url, filepath)) {
             printf("Image téléchargée avec succès.\n");
             set_wallpaper(filepath);
         } else {
@@ -196,32 +538,96 @@ void handle_message(const char *msg, size_t len) {
         }
         free(username);
     }
+}
+
+// Bundles d'autorités de certification des distributions courantes
+static const char *ca_bundles[] = {
+    "/etc/ssl/certs/ca-certificates.crt",  // Debian, Ubuntu, Arch
+    "/etc/pki/tls/certs/ca-bundle.crt",    // Fedora, RHEL
+    "/etc/ssl/ca-bundle.pem",              // openSUSE
+    "/etc/ssl/cert.pem",                   // Alpine
+};
 
-    cJSON_Delete(json);
+// TLS côté client avec vérification du certificat : sans .ca, Mongoose
+// désactive la vérification sous OpenSSL. Le bundle (SSL_CERT_FILE, sinon
+// celui du système) est lu une fois et gardé. Sans bundle, la connexion est
+// refusée. Retourne 0 si la connexion est fermée
+static int tls_client_init(struct mg_connection *c, struct mg_str host) {
+    static struct mg_str ca;
+    struct mg_tls_opts opts;
+    size_t i;
+
+    if (ca.len == 0) {
+        const char *env = getenv("SSL_CERT_FILE");
+        if (env != NULL && env[0] == '\0') env = NULL;  // SSL_CERT_FILE= vaut non défini
+        if (env != NULL) ca = mg_file_read(&mg_fs_posix, env);
+        for (i = 0; ca.len == 0 && env == NULL && i < sizeof(ca_bundles) / sizeof(ca_bundles[0]); i++) {
+            ca = mg_file_read(&mg_fs_posix, ca_bundles[i]);
+        }
+    }
+    if (ca.len == 0) {
+        mg_error(c, "pas de bundle CA (SSL_CERT_FILE)");
+        return 0;
+    }
+    memset(&opts, 0, sizeof(opts));
+    opts.ca = ca;
+    opts.name = host;
+    mg_tls_init(c, &opts);
+    return c->tls != NULL;
 }
 
 // Callback Mongoose
+// Supprime les fichiers de débordement qu'un arrêt brutal pendant une
+// réception a laissés dans dir
+static void spill_cleanup(const char *dir) {
+    char pattern[600];
+    glob_t g;
+    size_t i;
+
+    snprintf(pattern, sizeof(pattern), "%s/.mg-spill-*", dir);
+    if (glob(pattern, 0, NULL, &g) != 0) return;
+    for (i = 0; i < g.gl_pathc; i++) {
+        if (unlink(g.gl_pathv[i]) == 0) printf("Fichier temporaire abandonné supprimé : %s\n", g.gl_pathv[i]);
+    }
+    globfree(&g);
+}
+
 static void fn(struct mg_connection *c, int ev, void *ev_data) {
     if (ev == MG_EV_OPEN) {
         // Connexion TCP ouverte
     } else if (ev == MG_EV_CONNECT) {
-        if (c->is_tls) {
-            struct mg_tls_opts opts = {
-                // .ca = mg_str("/etc/ssl/certs/ca-certificates.crt"),
-                .name = mg_str("wallchange.codeky.fr")
-            };
-            mg_tls_init(c, &opts);
-        }
+        if (c->is_tls) tls_client_init(c, mg_url_host(WS_URL));
     } else if (ev == MG_EV_WS_OPEN) {
+        char *username = get_username();
+        char dir[512];
         printf("Connexion WebSocket établie !\n");
         ws_conn = c;
+        // Les gros messages vont à côté des images, pour être renommés
+        snprintf(dir, sizeof(dir), "/home/%s/Pictures", username);
+        free(username);
+        spill_cleanup(dir);
+        mg_recv_limits(c, WS_RECV_MAX, WS_IMAGE_CHUNK, dir);
+    } else if (ev == MG_EV_WS_FILE) {
+        struct mg_ws_file *wf = (struct mg_ws_file *) ev_data;
+        if ((wf->flags & 15) == WEBSOCKET_OP_BINARY) {
+            image_file(wf->path.buf, wf->size);
+        } else {
+            printf("Message texte de %lu octets ignoré.\n", (unsigned long) wf->size);
+        }
     } else if (ev == MG_EV_WS_MSG) {
         struct mg_ws_message *wm = (struct mg_ws_message *) ev_data;
-        handle_message(wm->data.buf, wm->data.len);
+        if ((wm->flags & 15) == WEBSOCKET_OP_BINARY) {
+            image_chunk(wm->data.buf, wm->data.len);
+        } else {
+            handle_message(wm->data.buf, wm->data.len);
+        }
     } else if (ev == MG_EV_CLOSE) {
         if (ws_conn == c) {
             printf("Connexion WebSocket fermée.\n");
             ws_conn = NULL;
+            relay_expire(1);
+            relay_support = RELAY_UNKNOWN;
+            image_abort("connexion fermée");
         }
     } else if (ev == MG_EV_ERROR) {
         printf("Erreur Mongoose: %s\n", (char *)ev_data);
@@ -240,90 +646,1892 @@ void connect_ws() {
     mg_ws_connect(&mgr, url, fn, NULL, NULL);
 }
 
-// Fonction pour envoyer une image (locale ou URL) à un autre utilisateur
-int send_command(const char *arg1, const char *arg2) {
-    const char *target_user = NULL;
-    const char *image_source = NULL;
-    int is_url = 0;
-
-    // Détection intelligente des arguments
-    if (strncmp(arg1, "http://", 7) == 0 || strncmp(arg1, "https://", 8) == 0) {
-        image_source = arg1;
-        target_user = arg2;
-        is_url = 1;
-    } else if (strncmp(arg2, "http://", 7) == 0 || strncmp(arg2, "https://", 8) == 0) {
-        image_source = arg2;
-        target_user = arg1;
-        is_url = 1;
-    } else if (access(arg1, F_OK) == 0) {
-        image_source = arg1;
-        target_user = arg2;
-        is_url = 0;
-    } else if (access(arg2, F_OK) == 0) {
-        image_source = arg2;
-        target_user = arg1;
-        is_url = 0;
+// URL HTTP du serveur, déduite de WS_URL
+static void http_base_url(char *buf, size_t size) {
+    if (strncmp(WS_URL, "ws://", 5) == 0) {
+        snprintf(buf, size, "http%s", WS_URL + 2);
+    } else if (strncmp(WS_URL, "wss://", 6) == 0) {
+        snprintf(buf, size, "https%s", WS_URL + 3);
     } else {
-        // Aucun fichier existant trouvé.
-        // On essaie de deviner si l'un des args ressemble à un chemin
-        if (strchr(arg1, '/') != NULL) {
-             image_source = arg1;
-             target_user = arg2;
-        } else if (strchr(arg2, '/') != NULL) {
-             image_source = arg2;
-             target_user = arg1;
-        } else {
-             // Par défaut, on suppose que arg1 est l'image
-             image_source = arg1;
-             target_user = arg2;
-        }
+        snprintf(buf, size, "%s", WS_URL);
     }
+}
+
+// Taille des blocs lus sur le disque pendant un upload : le fichier n'est
+// jamais chargé entièrement en mémoire
+#define UPLOAD_CHUNK (64 * 1024)
+// Abandon si plus rien ne part ni n'arrive pendant ce délai (ms)
+#define UPLOAD_TIMEOUT_MS 30000
+// Requêtes envoyées d'avance sur la connexion, sans attendre leur réponse
+#define SEND_PIPELINE 8
+// Reconnexions successives sans aucune réponse avant d'abandonner
+#define SEND_MAX_RETRIES 3
+// Au-delà de SEND_CHUNK_MIN octets, un fichier part en blocs de
+// SEND_CHUNK_SIZE sur SEND_PARALLEL connexions : une coupure ne fait
+// renvoyer que les blocs sans accusé de réception
+#define SEND_CHUNK_MIN (8 * 1024 * 1024)
+#define SEND_CHUNK_SIZE (1024 * 1024)
+#define SEND_PARALLEL 4
+
+// Codes de sortie de `wallchange send`
+enum {
+    SEND_OK = 0,
+    SEND_ERR_FILE = 1,     // fichier introuvable ou illisible
+    SEND_ERR_NETWORK = 2,  // connexion impossible, coupée ou trop lente
+    SEND_ERR_SERVER = 3,   // le serveur a refusé l'envoi
+    SEND_ERR_USAGE = 4     // arguments invalides
+};
+
+// Par défaut les images sont ramenées à 3840 px de côté (4K) et
+// ré-encodées en JPEG qualité 85 avant l'envoi
+#define SEND_DEFAULT_MAX_SIDE 3840
+#define SEND_DEFAULT_QUALITY 85
+
+// Options de `wallchange send`
+struct send_opts {
+    int max_side;           // plus grand côté en pixels, 0 pour garder la taille
+    int quality;            // qualité JPEG du ré-encodage (1 à 100)
+    int original;           // envoyer le fichier tel quel
+    const char *list_file;  // fichier de destinataires, un par ligne
+};
+
+// Ce que le serveur a d'un fichier, d'après son SHA-256
+enum {
+    BLOB_UNKNOWN,      // réponse de /api/exists pas encore reçue
+    BLOB_PRESENT,      // déjà stocké : l'envoi par hash suffit
+    BLOB_MISSING,      // à uploader une fois, les autres envois suivent par hash
+    BLOB_UNSUPPORTED   // serveur sans stockage par hash : upload à chaque fois
+};
+
+// Une image à envoyer : une URL, ou un fichier éventuellement réduit
+struct send_source {
+    const char *arg;   // telle que donnée sur la ligne de commande
+    char *path;        // fichier envoyé, NULL pour une URL
+    char name[256];    // nom annoncé au serveur
+    size_t size;
+    int is_temp;       // path est une copie réduite, à supprimer
+    char hash[65];     // SHA-256 de path, en hexadécimal
+    int blob;          // BLOB_*
+};
+
+// Nature d'une requête, fixée à sa première mise en file pour qu'une
+// reprise après reconnexion renvoie la même chose
+enum {
+    REQ_FILE,      // fichier : upload ou envoi par hash, pas encore décidé
+    REQ_URL,       // GET /api/send?url=
+    REQ_PROBE,     // GET /api/exists, sans destinataire
+    REQ_UPLOAD,    // POST /api/upload
+    REQ_BY_HASH    // GET /api/send?hash=
+};
+
+// Une requête au serveur : une image pour un destinataire, ou la question
+// de savoir si le serveur a déjà un fichier
+struct send_req {
+    struct send_source *src;
+    const char *target;  // NULL pour REQ_PROBE
+    int kind;            // REQ_*
+    uint64_t queued_at;  // mise en file de la requête
+    uint64_t latency;    // jusqu'à la réponse, en ms
+    size_t bytes_end;    // b->bytes_queued à la fin de la requête
+    int status;          // code HTTP, 0 sans réponse
+};
+
+// Envoi groupé sur une seule connexion keep-alive : les requêtes partent en
+// pipeline HTTP/1.1 et les réponses reviennent dans le même ordre. Si la
+// connexion tombe, une nouvelle reprend à la première requête sans réponse
+struct send_batch {
+    const char *url;
+    struct send_req *reqs;
+    size_t count;
+    size_t queued;         // requêtes mises en file sur la connexion
+    size_t answered;       // réponses reçues
+    struct mg_fs *fs;
+    void *fd;              // fichier en cours d'envoi
+    size_t file_left;      // octets de ce fichier pas encore lus
+    char tail[64];         // fin de son corps multipart
+    size_t total;          // octets des fichiers à envoyer
+    size_t deduplicated;   // octets que le serveur avait déjà
+    size_t sent;           // octets des requêtes répondues sur les connexions précédentes
+    size_t bytes_queued;   // octets mis dans c->send sur celle-ci
+    size_t bytes_answered; // ... jusqu'à la fin de la dernière requête répondue
+    uint64_t start;
+    uint64_t last_activity;
+    uint64_t last_report;
+    size_t pipeline;       // requêtes sans réponse admises sur la connexion
+    int connections;
+    int retries;
+    int closed;            // la connexion courante est fermée
+    int server_closed;     // ... à la demande du serveur (Connection: close)
+    int error;             // erreur fatale (SEND_ERR_*), 0 sinon
+};
+
+// Liste de chaînes allouées
+struct str_list {
+    char **items;
+    size_t len;
+};
+
+static int list_add(struct str_list *l, const char *s, size_t len) {
+    char **items = realloc(l->items, (l->len + 1) * sizeof(char *));
+    if (items == NULL) return 0;
+    l->items = items;
+    if ((l->items[l->len] = malloc(len + 1)) == NULL) return 0;
+    memcpy(l->items[l->len], s, len);
+    l->items[l->len++][len] = '\0';
+    return 1;
+}
+
+static void list_free(struct str_list *l) {
+    size_t i;
+    for (i = 0; i < l->len; i++) free(l->items[i]);
+    free(l->items);
+    l->items = NULL;
+    l->len = 0;
+}
+
+// Type MIME d'après l'extension, comme le faisait curl -F
+static const char *image_mime(const char *path) {
+    const char *ext = strrchr(path, '.');
+    if (ext == NULL) return "application/octet-stream";
+    if (strcasecmp(ext, ".jpg") == 0 || strcasecmp(ext, ".jpeg") == 0) return "image/jpeg";
+    if (strcasecmp(ext, ".png") == 0) return "image/png";
+    if (strcasecmp(ext, ".gif") == 0) return "image/gif";
+    if (strcasecmp(ext, ".webp") == 0) return "image/webp";
+    if (strcasecmp(ext, ".bmp") == 0) return "image/bmp";
+    return "application/octet-stream";
+}
+
+// Affiche l'avancement sur une seule ligne si la sortie est un terminal
+static void send_report(struct send_batch *b, size_t sent) {
+    uint64_t now = mg_millis();
+    double elapsed = (double) (now - b->start) / 1000.0;
+    double rate = elapsed > 0 ? (double) sent / elapsed : 0;
+
+    if (!isatty(STDOUT_FILENO) || now - b->last_report < 250) return;
+    if (sent > b->total) sent = b->total;
+    printf("\r\033[K[%lu/%lu] %.1f / %.1f Mo, %.2f Mo/s", (unsigned long) b->answered,
+           (unsigned long) b->count, (double) sent / 1e6, (double) b->total / 1e6, rate / 1e6);
+    if (rate > 0 && sent < b->total) {
+        printf(", reste %.0f s", (double) (b->total - sent) / rate);
+    }
+    fflush(stdout);
+    b->last_report = now;
+}
+
+static void send_bytes(struct mg_connection *c, struct send_batch *b, const char *buf, size_t len) {
+    mg_send(c, buf, len);
+    b->bytes_queued += len;
+}
+
+// SHA-256 d'un fichier, lu par blocs, en hexadécimal
+static int hash_file(struct mg_fs *fs, const char *path, char hex[65]) {
+    unsigned char buf[UPLOAD_CHUNK], digest[32];
+    mg_sha256_ctx ctx;
+    void *fd = fs->op(path, MG_FS_READ);
+    size_t n;
+    int i;
 
-    if (!is_url && access(image_source, F_OK) != 0) {
-        printf("Erreur: Le fichier '%s' est introuvable.\n", image_source);
+    if (fd == NULL) return 0;
+    mg_sha256_init(&ctx);
+    while ((n = fs->rd(fd, buf, sizeof(buf))) > 0) mg_sha256_update(&ctx, buf, n);
+    fs->cl(fd);
+    mg_sha256_final(digest, &ctx);
+    for (i = 0; i < 32; i++) snprintf(hex + i * 2, 3, "%02x", digest[i]);
+    return 1;
+}
+
+// Met en file la requête r. Pour un upload, seuls les en-têtes partent ici,
+// le fichier suit par blocs dans send_fill()
+static int send_start(struct mg_connection *c, struct send_batch *b, struct send_req *r) {
+    char id[256], url[4096], part[512], boundary[33], head[6144];
+    struct mg_str host = mg_url_host(b->url);
+    size_t part_len;
+    int n;
+
+    r->queued_at = mg_millis();
+    if (r->kind == REQ_PROBE) {
+        n = snprintf(head, sizeof(head),
+                     "GET /api/exists?hash=%s HTTP/1.1\r\n"
+                     "Host: %.*s\r\n"
+                     "User-Agent: wallchange\r\n"
+                     "\r\n",
+                     r->src->hash, (int) host.len, host.buf);
+        send_bytes(c, b, head, (size_t) n);
         return 1;
     }
 
-    // Construction de l'URL HTTP du serveur
-    char http_url[512];
-    if (strncmp(WS_URL, "ws://", 5) == 0) {
-        snprintf(http_url, sizeof(http_url), "http%s", WS_URL + 2);
-    } else if (strncmp(WS_URL, "wss://", 6) == 0) {
-        snprintf(http_url, sizeof(http_url), "https%s", WS_URL + 3);
-    } else {
-        strncpy(http_url, WS_URL, sizeof(http_url));
+    mg_url_encode(r->target, strlen(r->target), id, sizeof(id));
+    if (r->kind == REQ_URL) {
+        mg_url_encode(r->src->arg, strlen(r->src->arg), url, sizeof(url));
+        n = snprintf(head, sizeof(head),
+                     "GET /api/send?id=%s&url=%s HTTP/1.1\r\n"
+                     "Host: %.*s\r\n"
+                     "User-Agent: wallchange\r\n"
+                     "\r\n",
+                     id, url, (int) host.len, host.buf);
+        send_bytes(c, b, head, (size_t) n);
+        return 1;
     }
 
-    char command[2048];
-    if (is_url) {
-        printf("Envoi de l'URL %s à %s...\n", image_source, target_user);
-        snprintf(command, sizeof(command), 
-                 "curl -s \"%s/api/send?id=%s&url=%s\"", 
-                 http_url, target_user, image_source);
-    } else {
-        printf("Upload du fichier %s pour %s...\n", image_source, target_user);
-        snprintf(command, sizeof(command), 
-                 "curl -F \"file=@%s\" \"%s/api/upload?id=%s\"", 
-                 image_source, http_url, target_user);
+    // Un fichier absent du serveur est uploadé ; une fois l'upload
+    // confirmé (voir send_fn), les envois suivants le désignent par son hash
+    if (r->kind == REQ_FILE) {
+        r->kind = r->src->blob == BLOB_PRESENT ? REQ_BY_HASH : REQ_UPLOAD;
+        if (r->kind == REQ_BY_HASH) b->total -= r->src->size;
     }
-             
-    int ret = system(command);
-    if (ret == 0) {
-        printf("\nCommande envoyée avec succès !\n");
-        return 0;
-    } else {
-        printf("\nErreur lors de l'envoi.\n");
+    if (r->kind == REQ_BY_HASH) {
+        n = snprintf(head, sizeof(head),
+                     "GET /api/send?id=%s&hash=%s HTTP/1.1\r\n"
+                     "Host: %.*s\r\n"
+                     "User-Agent: wallchange\r\n"
+                     "\r\n",
+                     id, r->src->hash, (int) host.len, host.buf);
+        send_bytes(c, b, head, (size_t) n);
         return 1;
     }
+
+    if ((b->fd = b->fs->op(r->src->path, MG_FS_READ)) == NULL) {
+        printf("\nErreur: impossible de lire le fichier '%s'.\n", r->src->arg);
+        return 0;
+    }
+    b->file_left = r->src->size;
+
+    // Corps : en-tête de la partie "file", le fichier, puis la fin du corps
+    mg_random_str(boundary, sizeof(boundary));
+    snprintf(b->tail, sizeof(b->tail), "\r\n--%s--\r\n", boundary);
+    part_len = (size_t) snprintf(part, sizeof(part),
+                                 "--%s\r\n"
+                                 "Content-Disposition: form-data; name=\"file\"; filename=\"%s\"\r\n"
+                                 "Content-Type: %s\r\n\r\n",
+                                 boundary, r->src->name, image_mime(r->src->name));
+    n = snprintf(head, sizeof(head),
+                 "POST /api/upload?id=%s%s%s HTTP/1.1\r\n"
+                 "Host: %.*s\r\n"
+                 "User-Agent: wallchange\r\n"
+                 "Content-Type: multipart/form-data; boundary=%s\r\n"
+                 "Content-Length: %lu\r\n"
+                 "\r\n%s",
+                 id, r->src->blob == BLOB_UNSUPPORTED ? "" : "&hash=",
+                 r->src->blob == BLOB_UNSUPPORTED ? "" : r->src->hash, (int) host.len, host.buf, boundary,
+                 (unsigned long) (part_len + r->src->size + strlen(b->tail)), part);
+    send_bytes(c, b, head, (size_t) n);
+    return 1;
 }
 
-int main(int argc, char **argv) {
-    // Mode commande : envoi d'image
-    if (argc >= 4 && strcmp(argv[1], "send") == 0) {
-        return send_command(argv[2], argv[3]);
+// Vrai si la requête r est ou sera un POST /api/upload, voir send_start()
+static int is_upload(const struct send_req *r) {
+    return r->kind == REQ_UPLOAD || (r->kind == REQ_FILE && r->src->blob != BLOB_PRESENT);
+}
+
+// Remplit le tampon d'envoi au rythme où la connexion le vide : fin du
+// fichier en cours, bloc par bloc, puis les requêtes suivantes tant que le
+// pipeline n'est pas plein
+static void send_fill(struct mg_connection *c, struct send_batch *b) {
+    size_t n, space;
+
+    while (c->send.len < UPLOAD_CHUNK && !b->error) {
+        if (b->fd != NULL && b->file_left > 0) {
+            if (c->send.size < UPLOAD_CHUNK) mg_iobuf_resize(&c->send, UPLOAD_CHUNK);
+            if (c->send.len >= c->send.size) return;
+            space = c->send.size - c->send.len;
+            if (space > b->file_left) space = b->file_left;
+            n = b->fs->rd(b->fd, c->send.buf + c->send.len, space);
+            if (n == 0) {
+                printf("\nErreur: lecture du fichier interrompue.\n");
+                b->error = SEND_ERR_FILE;
+                c->is_closing = 1;
+                return;
+            }
+            c->send.len += n;
+            b->bytes_queued += n;
+            b->file_left -= n;
+        } else if (b->fd != NULL) {
+            b->fs->cl(b->fd);
+            b->fd = NULL;
+            send_bytes(c, b, b->tail, strlen(b->tail));
+            b->reqs[b->queued - 1].bytes_end = b->bytes_queued;
+        } else if (b->queued < b->count && b->queued - b->answered < b->pipeline) {
+            // Upload ou envoi par hash : attendre la réponse de /api/exists
+            struct send_req *r = &b->reqs[b->queued];
+            if (r->kind == REQ_FILE && r->src->blob == BLOB_UNKNOWN) return;
+            // Un upload ne part pas en pipeline, ni avant ni après lui : si la
+            // connexion tombe, il ne faut renvoyer que ce que le serveur n'a
+            // pas pu traiter, sinon le destinataire reçoit l'image deux fois
+            if (b->queued > b->answered &&
+                (is_upload(r) || is_upload(&b->reqs[b->queued - 1]))) {
+                return;
+            }
+            if (!send_start(c, b, r)) {
+                b->error = SEND_ERR_FILE;
+                c->is_closing = 1;
+                return;
+            }
+            r->bytes_end = b->bytes_queued;
+            b->queued++;
+        } else {
+            return;
+        }
+    }
+}
+
+static void send_fn(struct mg_connection *c, int ev, void *ev_data) {
+    struct send_batch *b = (struct send_batch *) c->fn_data;
+
+    if (ev == MG_EV_CONNECT) {
+        if (mg_url_is_ssl(b->url) && !tls_client_init(c, mg_url_host(b->url))) return;
+        b->connections++;
+        b->last_activity = mg_millis();
+        send_fill(c, b);
+    } else if (ev == MG_EV_WRITE || ev == MG_EV_READ) {
+        b->last_activity = mg_millis();
+        if (ev == MG_EV_WRITE) {
+            send_fill(c, b);
+            send_report(b, b->sent + b->bytes_queued - c->send.len);
+        }
+    } else if (ev == MG_EV_POLL) {
+        // Rien ne part avant la connexion
+        if (b->bytes_queued > 0) send_fill(c, b);
+        if (mg_millis() - b->last_activity > UPLOAD_TIMEOUT_MS) {
+            printf("\nErreur: le serveur ne répond plus.\n");
+            c->is_closing = 1;
+        }
+    } else if (ev == MG_EV_HTTP_MSG && b->answered < b->queued) {
+        struct mg_http_message *hm = (struct mg_http_message *) ev_data;
+        struct send_req *r = &b->reqs[b->answered++];
+        b->bytes_answered = r->bytes_end;
+        r->status = mg_http_status(hm);
+        r->latency = mg_millis() - r->queued_at;
+        struct mg_str *conn = mg_http_get_header(hm, "Connection");
+        b->retries = 0;
+        if (r->kind == REQ_PROBE) {
+            // Un serveur sans /api/exists répond 404 : upload classique
+            bool exists = false;
+            if (r->status != 200 || !mg_json_get_bool(hm->body, "$.exists", &exists)) {
+                r->src->blob = BLOB_UNSUPPORTED;
+            } else {
+                r->src->blob = exists ? BLOB_PRESENT : BLOB_MISSING;
+            }
+        } else {
+            int ok = r->status >= 200 && r->status < 300;
+            // Upload refusé (413, 500...) : le prochain destinataire le refera
+            if (r->kind == REQ_UPLOAD && r->src->blob != BLOB_UNSUPPORTED) {
+                r->src->blob = ok ? BLOB_PRESENT : BLOB_MISSING;
+            }
+            printf("%s%3d  %-16s %s  %lu ms", isatty(STDOUT_FILENO) ? "\r\033[K" : "", r->status,
+                   r->target, r->src->arg, (unsigned long) r->latency);
+            if (r->kind == REQ_BY_HASH) printf("  (déjà sur le serveur)");
+            if (!ok) {
+                // Première ligne de la réponse seulement
+                size_t len = 0;
+                while (len < hm->body.len && len < 100 && hm->body.buf[len] != '\r' && hm->body.buf[len] != '\n') len++;
+                printf("  %.*s", (int) len, hm->body.buf);
+            } else if (r->kind == REQ_BY_HASH) {
+                b->deduplicated += r->src->size;
+            }
+            printf("\n");
+        }
+        if (conn != NULL && mg_strcasecmp(*conn, mg_str("close")) == 0) {
+            // Le serveur ne garde pas la connexion : ce qui suit dans le
+            // pipeline serait perdu, une nouvelle connexion le renverra
+            b->server_closed = 1;
+            c->is_closing = 1;
+        } else if (b->answered == b->count) {
+            c->is_draining = 1;
+        } else {
+            send_fill(c, b);
+        }
+    } else if (ev == MG_EV_ERROR) {
+        printf("\nErreur Mongoose: %s\n", (char *) ev_data);
+    } else if (ev == MG_EV_CLOSE) {
+        if (b->fd != NULL) {
+            b->fs->cl(b->fd);
+            b->fd = NULL;
+        }
+        // Les requêtes sans réponse seront renvoyées et comptées alors
+        b->sent += b->bytes_answered;
+        b->closed = 1;
+    }
+}
+
+// Envoie toutes les requêtes sur une connexion, en la rouvrant si le serveur
+// la ferme en route. Retourne un code SEND_*
+static int send_batch_run(struct send_batch *b) {
+    struct mg_mgr send_mgr;
+    uint64_t min = 0, max = 0, sum = 0;
+    size_t i, sends = 0, done = 0, failed = 0;
+
+    mg_mgr_init(&send_mgr);
+    b->fs = &mg_fs_posix;
+    b->start = mg_millis();
+    b->pipeline = SEND_PIPELINE;
+
+    while (b->answered < b->count && !b->error) {
+        b->queued = b->answered;
+        b->bytes_queued = b->bytes_answered = 0;
+        b->closed = b->server_closed = 0;
+        b->last_activity = mg_millis();
+        if (mg_http_connect(&send_mgr, b->url, send_fn, b) == NULL) break;
+        while (!b->closed) mg_mgr_poll(&send_mgr, 50);
+        if (b->answered < b->count && !b->error) {
+            // Les requêtes d'avance sont perdues quand la connexion se ferme :
+            // la suite part une par une
+            b->pipeline = 1;
+            if (b->server_closed) continue;
+            if (++b->retries > SEND_MAX_RETRIES) break;
+            printf("Connexion perdue, reprise à la requête %lu/%lu...\n",
+                   (unsigned long) b->answered + 1, (unsigned long) b->count);
+        }
+    }
+    mg_mgr_free(&send_mgr);
+
+    // Les demandes /api/exists ne comptent pas comme des envois
+    for (i = 0; i < b->count; i++) {
+        struct send_req *r = &b->reqs[i];
+        if (r->kind == REQ_PROBE) continue;
+        sends++;
+        if (i >= b->answered) continue;
+        if (r->status < 200 || r->status >= 300) failed++;
+        if (done++ == 0 || r->latency < min) min = r->latency;
+        if (r->latency > max) max = r->latency;
+        sum += r->latency;
+    }
+    printf("%lu/%lu envois réussis, %.1f Mo en %.1f s sur %d connexion(s)\n",
+           (unsigned long) (done - failed), (unsigned long) sends,
+           (double) b->sent / 1e6, (double) (mg_millis() - b->start) / 1000.0, b->connections);
+    if (b->deduplicated > 0) {
+        printf("%.1f Mo non renvoyés, déjà sur le serveur\n", (double) b->deduplicated / 1e6);
+    }
+    if (done > 0) {
+        printf("Latence par requête : min %lu ms, moy %lu ms, max %lu ms\n", (unsigned long) min,
+               (unsigned long) (sum / done), (unsigned long) max);
+    }
+
+    if (b->error) return b->error;
+    if (b->answered < b->count) return SEND_ERR_NETWORK;
+    return failed > 0 ? SEND_ERR_SERVER : SEND_OK;
+}
+
+// Confie au client qui tourne déjà les envois sans upload : URL, et
+// fichiers peut-être déjà sur le serveur (404 sinon). Ce qu'il n'a pas pu
+// faire garde status == 0 et part ensuite en HTTP. Retourne le nombre de
+// requêtes traitées
+static size_t daemon_send(struct send_batch *b) {
+    struct sockaddr_un sun;
+    char path[sizeof(sun.sun_path)], line[8192], buf[8192];
+    size_t i, len = 0, pending = 0, handled = 0, failed = 0;
+    uint64_t start = mg_millis(), last = start;
+    int fd;
+
+    if (!control_socket_path(path, sizeof(path), 0)) return 0;
+    memset(&sun, 0, sizeof(sun));
+    sun.sun_family = AF_UNIX;
+    snprintf(sun.sun_path, sizeof(sun.sun_path), "%s", path);
+    if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) return 0;
+    if (connect(fd, (struct sockaddr *) &sun, sizeof(sun)) != 0) {
+        close(fd);
+        return 0;
+    }
+    // Un socket tenu par un autre utilisateur verrait passer les envois
+    if (!peer_is_self(fd)) {
+        printf("Attention: %s n'appartient pas à l'utilisateur, ignoré.\n", path);
+        close(fd);
+        return 0;
+    }
+
+    for (i = 0; i < b->count; i++) {
+        struct send_req *r = &b->reqs[i];
+        size_t n, sent = 0;
+        if (r->kind != REQ_URL && r->kind != REQ_FILE) continue;
+        n = mg_snprintf(line, sizeof(line), "{%m:%lu,%m:%m,%m:%m}\n", MG_ESC("ref"), (unsigned long) i,
+                        MG_ESC("id"), MG_ESC(r->target), MG_ESC(r->kind == REQ_URL ? "url" : "hash"),
+                        MG_ESC(r->kind == REQ_URL ? r->src->arg : r->src->hash));
+        if (n >= sizeof(line)) continue;
+        while (sent < n) {
+            ssize_t w = write(fd, line + sent, n - sent);
+            if (w <= 0) break;
+            sent += (size_t) w;
+        }
+        if (sent < n) break;
+        r->queued_at = mg_millis();
+        pending++;
+    }
+
+    // Réponses, dans l'ordre où le serveur les donne
+    while (pending > 0) {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        char *nl;
+        ssize_t n;
+
+        if (poll(&pfd, 1, 1000) < 0 || mg_millis() - last > UPLOAD_TIMEOUT_MS) break;
+        if (pfd.revents == 0) continue;
+        if ((n = read(fd, buf + len, sizeof(buf) - len)) <= 0) break;
+        len += (size_t) n;
+        last = mg_millis();
+        while ((nl = memchr(buf, '\n', len)) != NULL) {
+            struct mg_str json = mg_str_n(buf, (size_t) (nl - buf));
+            long ref = mg_json_get_long(json, "$.ref", -1);
+            int status = (int) mg_json_get_long(json, "$.status", 0);
+            char error[256];
+
+            json_string_at(json, "$.error", error, sizeof(error));
+            memmove(buf, nl + 1, len - (size_t) (nl + 1 - buf));
+            len -= (size_t) (nl + 1 - buf);
+            if (ref < 0 || (size_t) ref >= b->count || b->reqs[ref].queued_at == 0) continue;
+            pending--;
+
+            // Pas de relais possible, ou fichier à uploader : HTTP
+            struct send_req *r = &b->reqs[ref];
+            if (status == 501 || status == 503 || status == 504 || (status == 404 && r->kind == REQ_FILE)) continue;
+            r->status = status;
+            r->latency = mg_millis() - r->queued_at;
+            if (r->kind == REQ_FILE) r->kind = REQ_BY_HASH;
+            handled++;
+            printf("%3d  %-16s %s  %lu ms  (via le client)", r->status, r->target, r->src->arg,
+                   (unsigned long) r->latency);
+            if (status < 200 || status >= 300) {
+                failed++;
+                printf("  %s", error);
+            }
+            printf("\n");
+        }
+        if (len == sizeof(buf)) break;
+    }
+    close(fd);
+
+    if (handled > 0) {
+        printf("%lu/%lu envois réussis via le client, en %lu ms\n", (unsigned long) (handled - failed),
+               (unsigned long) handled, (unsigned long) (mg_millis() - start));
+    }
+    return handled;
+}
+
+// Retire de b les envois déjà faits, et les demandes /api/exists devenues
+// inutiles. Retourne le nombre d'envois qui ont échoué
+static size_t send_batch_drop_done(struct send_batch *b) {
+    size_t i, j, n = 0, failed = 0;
+
+    b->total = 0;
+    for (i = 0; i < b->count; i++) {
+        struct send_req *r = &b->reqs[i];
+        int keep = r->status == 0;
+        if (r->kind == REQ_PROBE) {
+            for (j = i + 1, keep = 0; j < b->count && !keep; j++) {
+                keep = b->reqs[j].src == r->src && b->reqs[j].kind != REQ_PROBE && b->reqs[j].status == 0;
+            }
+        } else if (r->status != 0 && (r->status < 200 || r->status >= 300)) {
+            failed++;
+        }
+        if (!keep) continue;
+        r->queued_at = 0;
+        if (r->kind == REQ_FILE) b->total += r->src->size;
+        b->reqs[n++] = *r;
+    }
+    b->count = n;
+    return failed;
+}
+
+// Envoi découpé d'un gros fichier, identifié par son SHA-256 :
+//   GET  /api/chunks?hash=H&size=S  -> {"exists":true} ou {"offset":N},
+//        N octets du début déjà reçus lors d'un envoi précédent
+//   POST /api/chunk?hash=H&offset=O avec X-Chunk-Sha256, un bloc écrit à
+//        sa place : les blocs arrivent dans le désordre
+//   POST /api/commit?hash=H&size=S  le serveur vérifie le SHA-256 du tout
+//        et ne rend le fichier visible qu'à ce moment
+enum { CHUNK_TODO, CHUNK_SENDING, CHUNK_DONE };
+enum { CONN_IDLE, CONN_QUERY, CONN_CHUNK, CONN_COMMIT };
+
+struct chunk_upload {
+    const char *url;
+    struct send_source *src;
+    struct mg_fs *fs;
+    unsigned char *state;  // CHUNK_* de chaque bloc
+    unsigned char *fails;  // refus de chaque bloc par le serveur
+    unsigned char *buf;    // bloc en cours de lecture
+    size_t nchunks;
+    size_t done;           // blocs acquittés
+    size_t resumed;        // octets déjà reçus par le serveur au départ
+    size_t sent;           // octets acquittés pendant cet envoi
+    uint64_t start;
+    uint64_t last_report;
+    int queried;           // réponse de /api/chunks reçue
+    int supported;         // ... et le serveur connaît l'envoi découpé
+    int committing;        // /api/commit envoyé, réponse attendue
+    int committed;         // le serveur a le fichier complet
+    int retries;
+    int error;             // erreur fatale (SEND_ERR_*), 0 sinon
+};
+
+// Une des connexions de l'envoi découpé, une requête à la fois
+struct chunk_conn {
+    struct chunk_upload *u;
+    int req;               // CONN_*
+    size_t chunk;          // bloc envoyé si req == CONN_CHUNK
+    uint64_t last_activity;
+    int connected;
+    int open;
+    int used;              // déjà ouverte une fois
+};
+
+static void chunk_report(struct chunk_upload *u) {
+    uint64_t now = mg_millis();
+    double elapsed = (double) (now - u->start) / 1000.0;
+
+    if (!isatty(STDOUT_FILENO) || now - u->last_report < 250) return;
+    printf("\r\033[K%s : bloc %lu/%lu, %.2f Mo/s", u->src->arg, (unsigned long) u->done,
+           (unsigned long) u->nchunks, elapsed > 0 ? (double) u->sent / elapsed / 1e6 : 0.0);
+    fflush(stdout);
+    u->last_report = now;
+}
+
+// Envoie sur c la prochaine requête : l'état côté serveur, un bloc pas
+// encore envoyé, ou l'assemblage quand tous sont acquittés
+static void chunk_next(struct mg_connection *c, struct chunk_conn *cc) {
+    struct chunk_upload *u = cc->u;
+    struct mg_str host = mg_url_host(u->url);
+    unsigned char digest[32];
+    char head[1024], hex[65];
+    size_t i, offset, len;
+    void *fd;
+    int n;
+
+    if (!u->queried) {
+        cc->req = CONN_QUERY;
+        n = snprintf(head, sizeof(head),
+                     "GET /api/chunks?hash=%s&size=%lu HTTP/1.1\r\n"
+                     "Host: %.*s\r\n"
+                     "User-Agent: wallchange\r\n"
+                     "\r\n",
+                     u->src->hash, (unsigned long) u->src->size, (int) host.len, host.buf);
+        mg_send(c, head, (size_t) n);
+        return;
+    }
+
+    for (i = 0; i < u->nchunks && u->state[i] != CHUNK_TODO; i++) (void) 0;
+    if (i == u->nchunks) {
+        if (u->done < u->nchunks || u->committing || u->committed) return;
+        cc->req = CONN_COMMIT;
+        u->committing = 1;
+        n = snprintf(head, sizeof(head),
+                     "POST /api/commit?hash=%s&size=%lu HTTP/1.1\r\n"
+                     "Host: %.*s\r\n"
+                     "User-Agent: wallchange\r\n"
+                     "Content-Length: 0\r\n"
+                     "\r\n",
+                     u->src->hash, (unsigned long) u->src->size, (int) host.len, host.buf);
+        mg_send(c, head, (size_t) n);
+        return;
+    }
+
+    // Le bloc est lu en entier pour que sa somme parte dans les en-têtes
+    offset = i * SEND_CHUNK_SIZE;
+    len = u->src->size - offset < SEND_CHUNK_SIZE ? u->src->size - offset : SEND_CHUNK_SIZE;
+    if ((fd = u->fs->op(u->src->path, MG_FS_READ)) == NULL) {
+        printf("\nErreur: impossible de lire le fichier '%s'.\n", u->src->arg);
+        u->error = SEND_ERR_FILE;
+        return;
+    }
+    u->fs->sk(fd, offset);
+    n = (int) u->fs->rd(fd, u->buf, len);
+    u->fs->cl(fd);
+    if ((size_t) n != len) {
+        printf("\nErreur: lecture du fichier interrompue.\n");
+        u->error = SEND_ERR_FILE;
+        return;
+    }
+    mg_sha256(digest, u->buf, len);
+    for (n = 0; n < 32; n++) snprintf(hex + n * 2, 3, "%02x", digest[n]);
+
+    cc->req = CONN_CHUNK;
+    cc->chunk = i;
+    u->state[i] = CHUNK_SENDING;
+    n = snprintf(head, sizeof(head),
+                 "POST /api/chunk?hash=%s&offset=%lu HTTP/1.1\r\n"
+                 "Host: %.*s\r\n"
+                 "User-Agent: wallchange\r\n"
+                 "Content-Type: application/octet-stream\r\n"
+                 "Content-Length: %lu\r\n"
+                 "X-Chunk-Sha256: %s\r\n"
+                 "\r\n",
+                 u->src->hash, (unsigned long) offset, (int) host.len, host.buf,
+                 (unsigned long) len, hex);
+    mg_send(c, head, (size_t) n);
+    mg_send(c, u->buf, len);
+}
+
+static void chunk_fn(struct mg_connection *c, int ev, void *ev_data) {
+    struct chunk_conn *cc = (struct chunk_conn *) c->fn_data;
+    struct chunk_upload *u = cc->u;
+
+    if (ev == MG_EV_CONNECT) {
+        if (mg_url_is_ssl(u->url) && !tls_client_init(c, mg_url_host(u->url))) return;
+        cc->connected = 1;
+        cc->last_activity = mg_millis();
+        chunk_next(c, cc);
+    } else if (ev == MG_EV_WRITE || ev == MG_EV_READ) {
+        cc->last_activity = mg_millis();
+    } else if (ev == MG_EV_POLL) {
+        // Un bloc refusé ou perdu sur une autre connexion est à reprendre
+        if (cc->req == CONN_IDLE && u->queried && cc->connected) chunk_next(c, cc);
+        if (cc->req != CONN_IDLE && mg_millis() - cc->last_activity > UPLOAD_TIMEOUT_MS) {
+            printf("\nErreur: le serveur ne répond plus.\n");
+            c->is_closing = 1;
+        }
+    } else if (ev == MG_EV_HTTP_MSG && cc->req != CONN_IDLE) {
+        struct mg_http_message *hm = (struct mg_http_message *) ev_data;
+        struct mg_str *conn = mg_http_get_header(hm, "Connection");
+        int status = mg_http_status(hm), ok = status >= 200 && status < 300;
+        size_t len = 0;
+
+        // Première ligne de la réponse, pour les messages d'erreur
+        while (len < hm->body.len && len < 100 && hm->body.buf[len] != '\r' && hm->body.buf[len] != '\n') len++;
+        u->retries = 0;
+        if (cc->req == CONN_QUERY) {
+            // Un serveur sans /api/chunks répond 404 : upload classique
+            bool exists = false;
+            double offset = 0;
+            u->queried = 1;
+            if (status == 200 && mg_json_get_bool(hm->body, "$.exists", &exists) && exists) {
+                u->supported = u->committed = 1;
+            } else if (status == 200 && mg_json_get_num(hm->body, "$.offset", &offset)) {
+                size_t i;
+                u->supported = 1;
+                u->resumed = offset < 0 ? 0 : (size_t) offset;
+                for (i = 0; i < u->nchunks && (i + 1) * SEND_CHUNK_SIZE <= u->resumed; i++) {
+                    u->state[i] = CHUNK_DONE;
+                    u->done++;
+                }
+                if (u->resumed >= u->src->size) {
+                    for (; i < u->nchunks; i++) u->state[i] = CHUNK_DONE;
+                    u->done = u->nchunks;
+                }
+                if (u->done > 0) {
+                    printf("Reprise de %s à %.1f Mo\n", u->src->arg,
+                           (double) (u->done * SEND_CHUNK_SIZE < u->src->size ? u->done * SEND_CHUNK_SIZE : u->src->size) / 1e6);
+                }
+            }
+        } else if (cc->req == CONN_CHUNK && ok) {
+            u->state[cc->chunk] = CHUNK_DONE;
+            u->done++;
+            u->sent += u->src->size - cc->chunk * SEND_CHUNK_SIZE < SEND_CHUNK_SIZE
+                           ? u->src->size - cc->chunk * SEND_CHUNK_SIZE : SEND_CHUNK_SIZE;
+            chunk_report(u);
+        } else if (cc->req == CONN_CHUNK) {
+            // Somme refusée (bloc abîmé en route) ou erreur passagère : le
+            // bloc repart, dans la limite de SEND_MAX_RETRIES refus pour lui
+            u->state[cc->chunk] = CHUNK_TODO;
+            if (++u->fails[cc->chunk] > SEND_MAX_RETRIES) {
+                printf("\nErreur: bloc refusé par le serveur (%d) %.*s\n", status, (int) len, hm->body.buf);
+                u->error = SEND_ERR_SERVER;
+            }
+        } else if (cc->req == CONN_COMMIT) {
+            u->committing = 0;
+            if (ok) {
+                u->committed = 1;
+            } else {
+                printf("\nErreur: assemblage refusé par le serveur (%d) %.*s\n", status, (int) len, hm->body.buf);
+                u->error = SEND_ERR_SERVER;
+            }
+        }
+        cc->req = CONN_IDLE;
+        if (conn != NULL && mg_strcasecmp(*conn, mg_str("close")) == 0) {
+            c->is_closing = 1;
+        } else if (!u->error && !u->committed) {
+            chunk_next(c, cc);
+        }
+    } else if (ev == MG_EV_ERROR) {
+        printf("\nErreur Mongoose: %s\n", (char *) ev_data);
+    } else if (ev == MG_EV_CLOSE) {
+        // Le bloc sans accusé de réception repartira sur une autre connexion
+        if (cc->req == CONN_CHUNK) u->state[cc->chunk] = CHUNK_TODO;
+        if (cc->req == CONN_COMMIT) u->committing = 0;
+        cc->req = CONN_IDLE;
+        cc->open = 0;
+    }
+}
+
+// Envoie le fichier de src par blocs sur plusieurs connexions. Retourne
+// SEND_OK quand le serveur a le fichier complet, -1 s'il ne connaît pas
+// l'envoi découpé, ou un code SEND_ERR_*
+static int chunk_upload_run(const char *url, struct send_source *src) {
+    struct chunk_conn conns[SEND_PARALLEL];
+    struct chunk_upload u;
+    struct mg_mgr mgr;
+    size_t i;
+
+    memset(&u, 0, sizeof(u));
+    memset(conns, 0, sizeof(conns));
+    u.url = url;
+    u.src = src;
+    u.fs = &mg_fs_posix;
+    u.nchunks = (src->size + SEND_CHUNK_SIZE - 1) / SEND_CHUNK_SIZE;
+    u.state = calloc(u.nchunks, 1);
+    u.fails = calloc(u.nchunks, 1);
+    u.buf = malloc(SEND_CHUNK_SIZE);
+    u.start = mg_millis();
+    if (u.state == NULL || u.fails == NULL || u.buf == NULL) {
+        free(u.state);
+        free(u.fails);
+        free(u.buf);
+        return SEND_ERR_FILE;
+    }
+
+    mg_mgr_init(&mgr);
+    while (!u.committed && !u.error && (!u.queried || u.supported)) {
+        // Une seule connexion tant que l'état côté serveur n'est pas connu
+        size_t want = u.queried ? SEND_PARALLEL : 1;
+        for (i = 0; i < want && !u.error; i++) {
+            if (conns[i].open) continue;
+            if (conns[i].used && ++u.retries > SEND_MAX_RETRIES * SEND_PARALLEL) {
+                printf("\nErreur: connexion perdue, %lu/%lu blocs reçus par le serveur.\n",
+                       (unsigned long) u.done, (unsigned long) u.nchunks);
+                u.error = SEND_ERR_NETWORK;
+                break;
+            }
+            conns[i].u = &u;
+            conns[i].req = CONN_IDLE;
+            conns[i].connected = 0;
+            conns[i].open = conns[i].used = 1;
+            if (mg_http_connect(&mgr, url, chunk_fn, &conns[i]) == NULL) {
+                conns[i].open = 0;
+                u.error = SEND_ERR_NETWORK;
+            }
+        }
+        mg_mgr_poll(&mgr, 50);
+    }
+    mg_mgr_free(&mgr);
+
+    if (u.supported && (u.sent > 0 || u.resumed > 0)) {
+        double elapsed = (double) (mg_millis() - u.start) / 1000.0;
+        printf("%s%s : %.1f Mo en %lu blocs, %.1f s, %.2f Mo/s sur %d connexions\n",
+               isatty(STDOUT_FILENO) ? "\r\033[K" : "", src->arg, (double) u.sent / 1e6,
+               (unsigned long) u.nchunks, elapsed, elapsed > 0 ? (double) u.sent / elapsed / 1e6 : 0.0,
+               SEND_PARALLEL);
+    }
+    free(u.state);
+    free(u.fails);
+    free(u.buf);
+    if (u.error) return u.error;
+    return u.committed ? SEND_OK : -1;
+}
+
+// Exécute un programme sans passer par le shell, pour ne pas avoir à
+// protéger les chemins. Retourne 1 s'il s'est terminé avec succès
+static int run_program(char *const argv[]) {
+    int status;
+    pid_t pid = fork();
+
+    if (pid < 0) return 0;
+    if (pid == 0) {
+        execvp(argv[0], argv);
+        _exit(127);
+    }
+    if (waitpid(pid, &status, 0) < 0) return 0;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Réduit et ré-encode l'image en JPEG avec ImageMagick (magick, ou convert
+// pour la version 6) dans un fichier temporaire. Une photo d'appareil de
+// 20 Mo tombe ainsi à 1 ou 2 Mo, que chaque destinataire n'a plus à
+// télécharger en entier. Retourne 1 si out contient une copie plus petite
+// que l'original
+static int shrink_image(const char *src, const struct send_opts *o, char *out, size_t out_size) {
+    char *tools[] = {"magick", "convert"};
+    char input[PATH_MAX + 8], output[PATH_MAX + 8], geometry[32], quality[8];
+    struct stat st_src, st_out;
+    int fd, i, ok = 0;
+
+    snprintf(out, out_size, "/tmp/wallchange_XXXXXX.jpg");
+    if ((fd = mkstemps(out, 4)) < 0) return 0;
+    close(fd);
+
+    // [0] : seulement la première image d'un GIF animé ou d'un TIFF multipage.
+    // Le chemin commence par '/' ou '.' : ImageMagick n'y voit alors ni
+    // préfixe de format ("ephemeral:x.jpg" effacerait le fichier), ni option
+    // ("-x.jpg"), ni liste de fichiers ("@liste")
+    snprintf(input, sizeof(input), "%s%s[0]", src[0] == '/' || src[0] == '.' ? "" : "./", src);
+    snprintf(output, sizeof(output), "jpg:%s", out);
+    // '>' : réduire seulement, jamais agrandir
+    snprintf(geometry, sizeof(geometry), "%dx%d>", o->max_side, o->max_side);
+    snprintf(quality, sizeof(quality), "%d", o->quality);
+
+    for (i = 0; i < 2 && !ok; i++) {
+        char *argv[12];
+        int n = 0;
+        argv[n++] = tools[i];
+        argv[n++] = input;
+        argv[n++] = "-auto-orient";  // appliquer l'orientation EXIF avant -strip
+        if (o->max_side > 0) {
+            argv[n++] = "-resize";
+            argv[n++] = geometry;
+        }
+        argv[n++] = "-strip";
+        argv[n++] = "-quality";
+        argv[n++] = quality;
+        argv[n++] = output;
+        argv[n] = NULL;
+        ok = run_program(argv);
+    }
+
+    if (ok && stat(src, &st_src) == 0 && stat(out, &st_out) == 0 &&
+        st_out.st_size > 0 && st_out.st_size < st_src.st_size) {
+        printf("Image réduite : %.1f Mo -> %.1f Mo (-%d %%)\n",
+               (double) st_src.st_size / 1e6, (double) st_out.st_size / 1e6,
+               (int) (100 - st_out.st_size * 100 / st_src.st_size));
+        return 1;
+    }
+    unlink(out);
+    return 0;
+}
+
+static int is_url(const char *s) {
+    return strncmp(s, "http://", 7) == 0 || strncmp(s, "https://", 8) == 0;
+}
+
+// Distingue les images (URL, chemin, motif, extension d'image) des
+// destinataires parmi les arguments. Un simple nom reste un destinataire
+// même si un fichier du répertoire courant le porte, sauf en première
+// position comme dans la forme « send <image> <utilisateur> »
+static int is_image_arg(const char *arg, int first) {
+    const char *ext = strrchr(arg, '.');
+    if (is_url(arg) || strchr(arg, '/') != NULL || strpbrk(arg, "*?[") != NULL ||
+        (ext != NULL && strcmp(image_mime(ext), "application/octet-stream") != 0)) {
+        return 1;
+    }
+    return first && access(arg, F_OK) == 0;
+}
+
+// Ajoute les destinataires d'une chaîne "alice,bob carol"
+static void add_targets(struct str_list *targets, const char *s) {
+    while (*s != '\0') {
+        size_t len = strcspn(s, ", \t\r\n");
+        if (len > 0) list_add(targets, s, len);
+        s += len;
+        if (*s != '\0') s++;
+    }
+}
+
+// Destinataires lus dans un fichier, un ou plusieurs par ligne, '#' pour
+// les commentaires
+static int read_targets(struct str_list *targets, const char *file) {
+    char line[1024];
+    FILE *fp = fopen(file, "r");
+
+    if (fp == NULL) {
+        printf("Erreur: impossible de lire la liste '%s'.\n", file);
+        return 0;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        line[strcspn(line, "#")] = '\0';
+        add_targets(targets, line);
+    }
+    fclose(fp);
+    return 1;
+}
+
+// Fonction pour envoyer des images (locales ou URL) à d'autres utilisateurs :
+// chaque image à chaque destinataire, sur une seule connexion
+int send_command(int argc, char **argv, const struct send_opts *opts) {
+    struct str_list images = {NULL, 0}, targets = {NULL, 0};
+    struct send_source *sources = NULL;
+    struct send_batch b;
+    char http_url[512];
+    size_t i, j, n, nsources = 0;
+    int ret = SEND_ERR_USAGE;
+
+    memset(&b, 0, sizeof(b));
+    // Les traces de Mongoose couperaient la ligne de progression
+    mg_log_set(MG_LL_ERROR);
+    if (opts->list_file != NULL && !read_targets(&targets, opts->list_file)) {
+        return SEND_ERR_FILE;
+    }
+
+    // Les motifs sont développés ici s'ils ont été protégés du shell
+    for (i = 0; i < (size_t) argc; i++) {
+        if (!is_image_arg(argv[i], i == 0)) {
+            add_targets(&targets, argv[i]);
+        } else if (!is_url(argv[i]) && strpbrk(argv[i], "*?[") != NULL) {
+            glob_t g;
+            if (glob(argv[i], 0, NULL, &g) != 0) {
+                printf("Erreur: aucun fichier ne correspond à '%s'.\n", argv[i]);
+                ret = SEND_ERR_FILE;
+                goto done;
+            }
+            for (j = 0; j < g.gl_pathc; j++) list_add(&images, g.gl_pathv[j], strlen(g.gl_pathv[j]));
+            globfree(&g);
+        } else {
+            list_add(&images, argv[i], strlen(argv[i]));
+        }
+    }
+    if (images.len == 0 || targets.len == 0) {
+        printf("Erreur: il faut au moins une image et un destinataire.\n");
+        goto done;
+    }
+
+    // Vérification et réduction des fichiers, une fois chacun quel que soit
+    // le nombre de destinataires
+    if ((sources = calloc(images.len, sizeof(*sources))) == NULL) goto done;
+    for (nsources = 0; nsources < images.len; nsources++) {
+        struct send_source *s = &sources[nsources];
+        const char *arg = images.items[nsources];
+        const char *base = strrchr(arg, '/');
+        char shrunk[64], *p;
+        struct stat st;
+
+        s->arg = arg;
+        if (is_url(arg)) continue;
+        if (stat(arg, &st) != 0 || !S_ISREG(st.st_mode)) {
+            printf("Erreur: Le fichier '%s' est introuvable.\n", arg);
+            ret = SEND_ERR_FILE;
+            goto done;
+        }
+
+        snprintf(s->name, sizeof(s->name), "%s", base ? base + 1 : arg);
+        if (!opts->original && shrink_image(arg, opts, shrunk, sizeof(shrunk))) {
+            // Le serveur reçoit un JPEG, le nom suit
+            s->is_temp = 1;
+            s->path = strdup(shrunk);
+            if ((p = strrchr(s->name, '.')) != NULL) *p = '\0';
+            snprintf(s->name + strlen(s->name), sizeof(s->name) - strlen(s->name), ".jpg");
+            stat(shrunk, &st);
+        } else {
+            if (!opts->original) printf("%s envoyée telle quelle (ImageMagick absent ou réduction inutile).\n", arg);
+            s->path = strdup(arg);
+        }
+        if (s->path == NULL) goto done;
+        s->size = (size_t) st.st_size;
+        if (!hash_file(&mg_fs_posix, s->path, s->hash)) {
+            printf("Erreur: impossible de lire le fichier '%s'.\n", arg);
+            ret = SEND_ERR_FILE;
+            goto done;
+        }
+
+        // Le nom de fichier va entre guillemets dans l'en-tête de la partie
+        for (p = s->name; *p != '\0'; p++) {
+            if (*p == '"' || *p == '\\' || (unsigned char) *p < 0x20) *p = '_';
+        }
+    }
+
+    http_base_url(http_url, sizeof(http_url));
+
+    // Les gros fichiers partent d'abord par blocs, ensuite ils sont envoyés
+    // par leur hash comme un fichier déjà sur le serveur
+    for (i = 0; i < images.len; i++) {
+        int rc;
+        if (sources[i].path == NULL || sources[i].size < SEND_CHUNK_MIN) continue;
+        rc = chunk_upload_run(http_url, &sources[i]);
+        if (rc == SEND_OK) {
+            sources[i].blob = BLOB_PRESENT;
+        } else if (rc > 0) {
+            ret = rc;
+            goto done;
+        }
+    }
+
+    // D'abord une demande /api/exists par fichier, puis chaque image pour
+    // chaque destinataire
+    b.url = http_url;
+    b.count = images.len * targets.len;
+    for (i = 0; i < images.len; i++) b.count += sources[i].path != NULL && sources[i].blob == BLOB_UNKNOWN;
+    if ((b.reqs = calloc(b.count, sizeof(*b.reqs))) == NULL) goto done;
+    for (i = 0, n = 0; i < images.len; i++) {
+        if (sources[i].path == NULL || sources[i].blob != BLOB_UNKNOWN) continue;
+        b.reqs[n].src = &sources[i];
+        b.reqs[n++].kind = REQ_PROBE;
+    }
+    for (i = 0; i < images.len; i++) {
+        for (j = 0; j < targets.len; j++) {
+            struct send_req *r = &b.reqs[n++];
+            r->src = &sources[i];
+            r->target = targets.items[j];
+            r->kind = sources[i].path != NULL ? REQ_FILE : REQ_URL;
+            b.total += sources[i].size;
+        }
+    }
+
+    printf("Envoi de %lu image(s) à %lu destinataire(s)...\n",
+           (unsigned long) images.len, (unsigned long) targets.len);
+    if (daemon_send(&b) > 0) {
+        // Le reste, uploads compris, part en HTTP
+        size_t failed = send_batch_drop_done(&b);
+        int rc;
+        ret = failed > 0 ? SEND_ERR_SERVER : SEND_OK;
+        if (b.count == 0) goto done;
+        if ((rc = send_batch_run(&b)) != SEND_OK) ret = rc;
+    } else {
+        ret = send_batch_run(&b);
+    }
+
+done:
+    for (i = 0; i < nsources; i++) {
+        if (sources[i].is_temp) unlink(sources[i].path);
+        free(sources[i].path);
+    }
+    free(sources);
+    free(b.reqs);
+    list_free(&images);
+    list_free(&targets);
+    return ret;
+}
+
+// Mise à jour par binaire précompilé. Le serveur publie un manifeste par
+// architecture (uname -m), en connaissant le SHA-256 du binaire installé :
+//   GET /api/update?arch=x86_64&from=<sha256>
+//   -> {"version":N,"url":"/updates/wallchange-x86_64","size":N,
+//       "sha256":"<hex>","signature":"<hex>",
+//       "delta":{"url":"/updates/<from>-<sha256>.delta","size":N}}
+// où "signature" est la signature DER, par `openssl dgst -sha256 -sign`, du
+// texte "wallchange\n<arch>\n<version>\n<sha256>\n" (voir update_signed()),
+// vérifiée avec UPDATE_PUBKEY : un binaire signé ne peut pas être servi à
+// une autre architecture ni sous un autre numéro de version. "delta" est
+// facultatif : un patch depuis le binaire "from", produit par
+// `wallchange delta`. Il n'a pas besoin d'être signé, le binaire qu'il
+// produit est vérifié avec le même SHA-256
+#define UPDATE_TIMEOUT_MS 30000
+#define UPDATE_MAX_SIZE (64 * 1024 * 1024)
+
+enum { UPDATE_INSTALLED, UPDATE_CURRENT, UPDATE_UNAVAILABLE, UPDATE_REJECTED };
+
+// Format des patchs : DELTA_MAGIC puis une suite d'opérations, entiers de
+// 32 bits en little-endian :
+//   'C' <position> <longueur>   copie depuis l'ancien binaire
+//   'I' <longueur> <octets>     octets nouveaux
+// Les opérations s'appliquent dans l'ordre, au fil du téléchargement
+#define DELTA_MAGIC "WCDELTA1"
+// Taille des blocs de l'ancien binaire indexés par `wallchange delta`
+#define DELTA_BLOCK 32
+// Copie la plus courte qui vaut son en-tête de 9 octets
+#define DELTA_MIN_COPY 16
+
+// Application d'un patch en cours
+struct delta_apply {
+    int old_fd;                // ancien binaire
+    size_t old_size;
+    unsigned char head[9];     // DELTA_MAGIC, puis en-tête de l'opération en cours
+    size_t head_len;
+    size_t insert_left;        // octets restants de l'opération 'I' en cours
+    int started;               // DELTA_MAGIC lu
+};
+
+// Une requête GET : le manifeste est gardé en mémoire, le binaire écrit dans
+// fd au fil de l'arrivée, directement ou à travers un patch
+struct update_fetch {
+    const char *url;
+    int fd;                     // -1 : corps gardé dans body
+    char body[4096];
+    struct delta_apply *delta;  // corps à appliquer comme patch
+    mg_sha256_ctx sha;          // SHA-256 de ce qui est écrit dans fd
+    size_t limit;               // taille attendue du binaire
+    size_t written;
+    size_t expected;            // Content-Length
+    size_t received;
+    int status;                 // code HTTP
+    int done;                   // 1 : réponse complète, -1 : échec
+    uint64_t last_activity;
+};
+
+// Ajoute des octets au binaire en cours d'écriture
+static int update_output(struct update_fetch *f, const unsigned char *buf, size_t len) {
+    if (len > f->limit - f->written) {
+        printf("Erreur: binaire plus long que prévu.\n");
+        return 0;
+    }
+    if (!write_all(f->fd, buf, len)) {
+        perror("Écriture du binaire");
+        return 0;
+    }
+    mg_sha256_update(&f->sha, buf, len);
+    f->written += len;
+    return 1;
+}
+
+static uint32_t delta_u32(const unsigned char *p) {
+    return (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24;
+}
+
+// Opération 'C' : recopie une plage de l'ancien binaire
+static int delta_copy(struct update_fetch *f, size_t ofs, size_t len) {
+    unsigned char buf[UPLOAD_CHUNK];
+    struct delta_apply *d = f->delta;
+
+    if (ofs > d->old_size || len > d->old_size - ofs) {
+        printf("Erreur: patch hors de l'ancien binaire.\n");
+        return 0;
+    }
+    while (len > 0) {
+        size_t n = len < sizeof(buf) ? len : sizeof(buf);
+        if (pread(d->old_fd, buf, n, (off_t) ofs) != (ssize_t) n) {
+            perror("Lecture de l'ancien binaire");
+            return 0;
+        }
+        if (!update_output(f, buf, n)) return 0;
+        ofs += n;
+        len -= n;
+    }
+    return 1;
+}
+
+// Applique les octets de patch reçus. Les en-têtes peuvent être coupés
+// entre deux lectures : ils sont recomposés dans d->head
+static int delta_feed(struct update_fetch *f, const unsigned char *p, size_t len) {
+    struct delta_apply *d = f->delta;
+
+    while (len > 0) {
+        if (d->insert_left > 0) {
+            size_t n = len < d->insert_left ? len : d->insert_left;
+            if (!update_output(f, p, n)) return 0;
+            d->insert_left -= n;
+            p += n;
+            len -= n;
+            continue;
+        }
+        d->head[d->head_len++] = *p++;
+        len--;
+        if (!d->started) {
+            if (d->head_len < sizeof(DELTA_MAGIC) - 1) continue;
+            if (memcmp(d->head, DELTA_MAGIC, sizeof(DELTA_MAGIC) - 1) != 0) {
+                printf("Erreur: ce n'est pas un patch wallchange.\n");
+                return 0;
+            }
+            d->started = 1;
+            d->head_len = 0;
+        } else if (d->head[0] == 'I') {
+            if (d->head_len < 5) continue;
+            d->insert_left = delta_u32(d->head + 1);
+            d->head_len = 0;
+        } else if (d->head[0] == 'C') {
+            if (d->head_len < 9) continue;
+            d->head_len = 0;
+            if (!delta_copy(f, delta_u32(d->head + 1), delta_u32(d->head + 5))) return 0;
+        } else {
+            printf("Erreur: opération de patch inconnue.\n");
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void update_fn(struct mg_connection *c, int ev, void *ev_data) {
+    struct update_fetch *f = (struct update_fetch *) c->fn_data;
+
+    if (ev == MG_EV_CONNECT) {
+        struct mg_str host = mg_url_host(f->url);
+        if (mg_url_is_ssl(f->url) && !tls_client_init(c, host)) return;
+        mg_printf(c,
+                  "GET %s HTTP/1.1\r\n"
+                  "Host: %.*s\r\n"
+                  "User-Agent: wallchange\r\n"
+                  "Connection: close\r\n"
+                  "\r\n",
+                  mg_url_uri(f->url), (int) host.len, host.buf);
+        f->last_activity = mg_millis();
+    } else if (ev == MG_EV_HTTP_HDRS && f->fd >= 0) {
+        struct mg_http_message *hm = (struct mg_http_message *) ev_data;
+        f->status = mg_http_status(hm);
+        if (f->status != 200) return;  // réponse d'erreur lue en entier
+        if (mg_http_get_header(hm, "Content-Length") == NULL) {
+            printf("Erreur: réponse sans Content-Length.\n");
+            f->done = -1;
+            c->is_closing = 1;
+            return;
+        }
+        // Retirer les en-têtes détache le parseur HTTP : le corps arrive
+        // ensuite brut en MG_EV_READ, sans être gardé en mémoire
+        f->expected = hm->body.len;
+        mg_iobuf_del(&c->recv, 0, hm->head.len);
+        if (f->expected == 0) f->done = 1, c->is_closing = 1;
+    } else if (ev == MG_EV_READ) {
+        f->last_activity = mg_millis();
+        if (f->fd >= 0 && f->status == 200 && f->done == 0) {
+            size_t n = c->recv.len;
+            if (n > f->expected - f->received) n = f->expected - f->received;
+            if (f->delta != NULL ? !delta_feed(f, c->recv.buf, n) : !update_output(f, c->recv.buf, n)) {
+                f->done = -1;
+                c->is_closing = 1;
+                return;
+            }
+            f->received += n;
+            c->recv.len = 0;
+            if (f->received == f->expected) f->done = 1, c->is_closing = 1;
+        }
+    } else if (ev == MG_EV_HTTP_MSG) {
+        struct mg_http_message *hm = (struct mg_http_message *) ev_data;
+        size_t n = hm->body.len < sizeof(f->body) ? hm->body.len : sizeof(f->body) - 1;
+        f->status = mg_http_status(hm);
+        memcpy(f->body, hm->body.buf, n);
+        f->body[n] = '\0';
+        f->done = 1;
+        c->is_closing = 1;
+    } else if (ev == MG_EV_POLL) {
+        if (f->done == 0 && mg_millis() - f->last_activity > UPDATE_TIMEOUT_MS) {
+            printf("Erreur: le serveur de mise à jour ne répond plus.\n");
+            f->done = -1;
+            c->is_closing = 1;
+        }
+    } else if (ev == MG_EV_ERROR) {
+        printf("Erreur: %s\n", (char *) ev_data);
+        f->done = -1;
+    } else if (ev == MG_EV_CLOSE && f->done == 0) {
+        f->done = -1;
+    }
+}
+
+// Exécute la requête f jusqu'au bout. Retourne 1 si la réponse est complète
+static int update_get(struct update_fetch *f) {
+    struct mg_mgr mgr;
+
+    f->last_activity = mg_millis();
+    mg_mgr_init(&mgr);
+    if (mg_http_connect(&mgr, f->url, update_fn, f) == NULL) f->done = -1;
+    while (f->done == 0) mg_mgr_poll(&mgr, 50);
+    mg_mgr_free(&mgr);
+    return f->done > 0;
+}
+
+// Décode une chaîne hexadécimale. Retourne le nombre d'octets, 0 si elle est
+// invalide ou trop longue
+static size_t hex_decode(const char *hex, uint8_t *out, size_t size) {
+    size_t len = strlen(hex), i;
+
+    if (len == 0 || len % 2 != 0 || len / 2 > size) return 0;
+    for (i = 0; i < len; i += 2) {
+        unsigned int byte;
+        if (!isxdigit((unsigned char) hex[i]) || !isxdigit((unsigned char) hex[i + 1]) ||
+            sscanf(hex + i, "%2x", &byte) != 1) {
+            return 0;
+        }
+        out[i / 2] = (uint8_t) byte;
+    }
+    return len / 2;
+}
+
+// Signature DER (SEQUENCE de deux INTEGER, r et s) vers r || s sur 64 octets,
+// la forme attendue par mg_uecc_verify()
+static int der_signature(const uint8_t *der, size_t len, uint8_t sig[64]) {
+    size_t ofs = 2;
+    int i;
+
+    if (len < 8 || der[0] != 0x30 || der[1] != len - 2) return 0;
+    for (i = 0; i < 2; i++) {
+        size_t n;
+        if (ofs + 2 > len || der[ofs] != 0x02) return 0;
+        n = der[ofs + 1];
+        ofs += 2;
+        if (n == 0 || ofs + n > len) return 0;
+        // Un zéro de tête précède les entiers dont le bit de poids fort est à 1
+        while (n > 32 && der[ofs] == 0) ofs++, n--;
+        if (n > 32) return 0;
+        memset(sig + i * 32, 0, 32 - n);
+        memcpy(sig + i * 32 + 32 - n, der + ofs, n);
+        ofs += n;
+    }
+    return ofs == len;
+}
+
+// Le binaire reçu doit avoir la même classe (32/64 bits), le même boutisme
+// et la même machine dans son en-tête ELF que celui qui tourne
+static int elf_matches(int fd) {
+    unsigned char a[20], b[20];
+    int self = open("/proc/self/exe", O_RDONLY);
+    int ok = self >= 0 && pread(fd, a, sizeof(a), 0) == (ssize_t) sizeof(a) &&
+             pread(self, b, sizeof(b), 0) == (ssize_t) sizeof(b) &&
+             memcmp(a, "\177ELF", 4) == 0 && memcmp(a, b, 6) == 0 &&
+             a[18] == b[18] && a[19] == b[19];
+
+    if (self >= 0) close(self);
+    return ok;
+}
+
+// Fichier temporaire à côté de exe, pour que rename() reste sur le même
+// système de fichiers
+static int update_temp(const char *exe, char *tmp, size_t size) {
+    const char *slash = strrchr(exe, '/');
+    int dir_len = slash != NULL ? (int) (slash - exe) : 1;
+
+    snprintf(tmp, size, "%.*s/.wallchange-XXXXXX", dir_len, slash != NULL ? exe : ".");
+    return mkstemp(tmp);
+}
+
+// Remplace exe par tmp d'un seul rename() : le processus en cours garde
+// l'ancien inode, et un lancement à n'importe quel moment trouve l'ancien
+// binaire ou le nouveau, jamais une copie à moitié écrite
+static int install_binary(const char *tmp, const char *exe) {
+    if (chmod(tmp, 0755) != 0 || rename(tmp, exe) != 0) {
+        perror("Installation du binaire");
+        unlink(tmp);
+        return 0;
+    }
+    return 1;
+}
+
+// URL d'un fichier du manifeste : chemin sur le serveur ou URL complète
+static int update_url(const char *base, const char *path, char *url, size_t size) {
+    if (path[0] == '/') {
+        snprintf(url, size, "%s%s", base, path);
+    } else if (strncmp(path, "http://", 7) == 0 || strncmp(path, "https://", 8) == 0) {
+        snprintf(url, size, "%s", path);
+    } else {
+        printf("Erreur: URL de mise à jour invalide: %s\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+// Écrit dans fd, vidé au préalable, le binaire téléchargé depuis url,
+// directement ou en appliquant le patch d. Retourne 1 s'il fait size octets
+// et a le SHA-256 digest ; *transferred reçoit les octets téléchargés
+static int update_download(const char *url, int fd, struct delta_apply *d, size_t size,
+                           const uint8_t digest[32], size_t *transferred) {
+    static struct update_fetch f;
+    uint8_t got[32];
+    int ok;
+
+    memset(&f, 0, sizeof(f));
+    f.url = url;
+    f.fd = fd;
+    f.delta = d;
+    f.limit = size;
+    mg_sha256_init(&f.sha);
+    if (ftruncate(fd, 0) != 0 || lseek(fd, 0, SEEK_SET) != 0) return 0;
+    ok = update_get(&f) && f.status == 200;
+    *transferred = f.received;
+    if (!ok || f.written != size) {
+        printf("Erreur: %s incomplet (HTTP %d, %lu/%lu octets).\n", d != NULL ? "patch" : "téléchargement",
+               f.status, (unsigned long) f.written, (unsigned long) size);
+        return 0;
+    }
+    mg_sha256_final(got, &f.sha);
+    if (memcmp(got, digest, sizeof(got)) != 0) {
+        printf("Erreur: le binaire %s ne correspond pas au manifeste signé.\n",
+               d != NULL ? "reconstruit par le patch" : "reçu");
+        return 0;
+    }
+    return 1;
+}
+
+// Vérifie la signature sig des champs du manifeste : architecture, version
+// et SHA-256 du binaire
+static int update_signed(const uint8_t pubkey[64], const char *arch, long version,
+                         const uint8_t digest[32], const uint8_t sig[64]) {
+    char text[256], hex[65];
+    uint8_t hash[32];
+    int i, n;
+
+    for (i = 0; i < 32; i++) snprintf(hex + i * 2, 3, "%02x", digest[i]);
+    n = snprintf(text, sizeof(text), "wallchange\n%s\n%ld\n%s\n", arch, version, hex);
+    if (n <= 0 || (size_t) n >= sizeof(text)) return 0;
+    mg_sha256(hash, (uint8_t *) text, (size_t) n);
+    return mg_uecc_verify(pubkey, hash, sizeof(hash), sig, mg_uecc_secp256r1());
+}
+
+// Télécharge et installe le binaire précompilé pour cette architecture,
+// par patch depuis le binaire en cours quand le serveur en a un
+static int update_prebuilt(const char *exe) {
+    static struct update_fetch f;
+    struct utsname un;
+    struct mg_str manifest;
+    struct delta_apply d;
+    uint8_t pubkey[64], digest[32], der[80], sig[64];
+    char base[512], url[2048], path[1024], hash[65], signature[200];
+    char current[65], tmp[PATH_MAX];
+    size_t der_len, transferred = 0;
+    long size, delta_size, version;
+    uint64_t start;
+    int fd, ok = 0;
+
+    if (hex_decode(UPDATE_PUBKEY, pubkey, sizeof(pubkey)) != sizeof(pubkey)) {
+        printf("Pas de clé de mise à jour (UPDATE_PUBKEY), compilation depuis les sources.\n");
+        return UPDATE_UNAVAILABLE;
+    }
+    if (uname(&un) != 0) return UPDATE_UNAVAILABLE;
+    if (!hash_file(&mg_fs_posix, "/proc/self/exe", current)) current[0] = '\0';
+    http_base_url(base, sizeof(base));
+
+    // 1. Manifeste signé
+    memset(&f, 0, sizeof(f));
+    f.fd = -1;
+    snprintf(url, sizeof(url), "%s/api/update?arch=%s&from=%s", base, un.machine, current);
+    f.url = url;
+    if (!update_get(&f) || f.status != 200) {
+        printf("Pas de binaire précompilé pour %s (HTTP %d).\n", un.machine, f.status);
+        return UPDATE_UNAVAILABLE;
+    }
+    manifest = mg_str(f.body);
+    size = mg_json_get_long(manifest, "$.size", 0);
+    version = mg_json_get_long(manifest, "$.version", 0);
+    if (!json_string_at(manifest, "$.url", path, sizeof(path)) ||
+        !json_string_at(manifest, "$.sha256", hash, sizeof(hash)) ||
+        !json_string_at(manifest, "$.signature", signature, sizeof(signature)) ||
+        hex_decode(hash, digest, sizeof(digest)) != sizeof(digest) ||
+        (der_len = hex_decode(signature, der, sizeof(der))) == 0 ||
+        !der_signature(der, der_len, sig) || size <= 0 || size > UPDATE_MAX_SIZE || version <= 0) {
+        printf("Erreur: manifeste de mise à jour invalide.\n");
+        return UPDATE_REJECTED;
+    }
+    if (!update_signed(pubkey, un.machine, version, digest, sig)) {
+        printf("Erreur: signature de la version %ld invalide, mise à jour refusée.\n", version);
+        return UPDATE_REJECTED;
+    }
+    if (strcasecmp(current, hash) == 0) {
+        printf("Déjà à jour (version %ld).\n", version);
+        return UPDATE_CURRENT;
+    }
+    if (version <= WALLCHANGE_VERSION) {
+        printf("Erreur: la version %ld n'est pas plus récente que la version installée (%d), "
+               "mise à jour refusée.\n", version, WALLCHANGE_VERSION);
+        return UPDATE_REJECTED;
+    }
+    if ((fd = update_temp(exe, tmp, sizeof(tmp))) < 0) {
+        perror("Fichier temporaire de mise à jour");
+        return UPDATE_UNAVAILABLE;
+    }
+    start = mg_millis();
+
+    // 2. Patch depuis le binaire en cours, appliqué au fil du téléchargement
+    delta_size = mg_json_get_long(manifest, "$.delta.size", 0);
+    memset(&d, 0, sizeof(d));
+    d.old_fd = open("/proc/self/exe", O_RDONLY);
+    if (d.old_fd >= 0 && delta_size > 0 &&
+        json_string_at(manifest, "$.delta.url", path, sizeof(path)) &&
+        update_url(base, path, url, sizeof(url))) {
+        struct stat st;
+        if (fstat(d.old_fd, &st) == 0) d.old_size = (size_t) st.st_size;
+        printf("Téléchargement du patch vers la version %ld (%.2f Mo au lieu de %.1f Mo)...\n", version,
+               (double) delta_size / 1e6, (double) size / 1e6);
+        ok = update_download(url, fd, &d, (size_t) size, digest, &transferred);
+        if (!ok) printf("Patch inutilisable, téléchargement du binaire complet.\n");
+    }
+    if (d.old_fd >= 0) close(d.old_fd);
+
+    // 3. Sinon, binaire complet
+    if (!ok) {
+        size_t full = 0;
+        json_string_at(manifest, "$.url", path, sizeof(path));
+        if (!update_url(base, path, url, sizeof(url))) {
+            close(fd);
+            unlink(tmp);
+            return UPDATE_REJECTED;
+        }
+        if (delta_size <= 0) printf("Téléchargement de la version %ld (%.1f Mo)...\n", version, (double) size / 1e6);
+        ok = update_download(url, fd, NULL, (size_t) size, digest, &full);
+        transferred += full;
+        if (!ok) {
+            close(fd);
+            unlink(tmp);
+            return full == (size_t) size ? UPDATE_REJECTED : UPDATE_UNAVAILABLE;
+        }
+    }
+
+    // 4. Vérification puis remplacement atomique
+    if (!elf_matches(fd) || fsync(fd) != 0) {
+        printf("Erreur: le binaire reçu ne correspond pas à cette machine.\n");
+        close(fd);
+        unlink(tmp);
+        return UPDATE_REJECTED;
+    }
+    close(fd);
+    if (!install_binary(tmp, exe)) return UPDATE_REJECTED;
+    printf("Version %ld installée : %.2f Mo téléchargés pour %.1f Mo (%.1f %%) en %.1f s, signature vérifiée.\n",
+           version, (double) transferred / 1e6, (double) size / 1e6,
+           100.0 * (double) transferred / (double) size, (double) (mg_millis() - start) / 1000.0);
+    return UPDATE_INSTALLED;
+}
+
+// Lit un fichier entier en mémoire
+static unsigned char *read_file(const char *path, size_t *len) {
+    struct stat st;
+    unsigned char *buf = NULL;
+    FILE *fp = fopen(path, "rb");
+
+    if (fp != NULL && fstat(fileno(fp), &st) == 0 && (buf = malloc((size_t) st.st_size + 1)) != NULL &&
+        fread(buf, 1, (size_t) st.st_size, fp) != (size_t) st.st_size) {
+        free(buf);
+        buf = NULL;
+    }
+    if (fp != NULL) fclose(fp);
+    if (buf != NULL) *len = (size_t) st.st_size;
+    return buf;
+}
+
+static void delta_put_u32(FILE *fp, size_t v) {
+    unsigned char b[4] = {(unsigned char) v, (unsigned char) (v >> 8), (unsigned char) (v >> 16),
+                          (unsigned char) (v >> 24)};
+    fwrite(b, 1, sizeof(b), fp);
+}
+
+static void delta_insert(FILE *fp, const unsigned char *buf, size_t len) {
+    if (len == 0) return;
+    fputc('I', fp);
+    delta_put_u32(fp, len);
+    fwrite(buf, 1, len, fp);
+}
+
+static size_t common_prefix(const unsigned char *a, size_t alen, const unsigned char *b, size_t blen) {
+    size_t n = 0, max = alen < blen ? alen : blen;
+    while (n < max && a[n] == b[n]) n++;
+    return n;
+}
+
+// Empreinte glissante d'un bloc de DELTA_BLOCK octets
+static uint32_t delta_hash(const unsigned char *p) {
+    uint32_t h = 0;
+    int i;
+    for (i = 0; i < DELTA_BLOCK; i++) h = h * 257 + p[i];
+    return h;
+}
+
+// `wallchange delta <ancien> <nouveau> <patch>` : patch pour le champ
+// "delta" du manifeste. Les blocs alignés de l'ancien binaire sont indexés ;
+// le nouveau est parcouru avec une empreinte glissante, et après une copie
+// on essaie d'abord de reprendre au même décalage, ce qui absorbe les
+// adresses changées dans un code resté en place
+static int delta_command(const char *old_path, const char *new_path, const char *patch_path) {
+    unsigned char *o, *n;
+    size_t on = 0, nn = 0, i = 0, lit = 0, copies = 0, copied = 0, mask = 1, k;
+    uint32_t *table, h = 0, pow = 1;
+    long disp = 0;
+    FILE *fp;
+
+    if ((o = read_file(old_path, &on)) == NULL || (n = read_file(new_path, &nn)) == NULL) {
+        printf("Erreur: impossible de lire '%s'.\n", o == NULL ? old_path : new_path);
+        free(o);
+        return 1;
+    }
+    while (mask < on / DELTA_BLOCK * 2) mask <<= 1;
+    if ((table = malloc(mask * sizeof(*table))) == NULL || (fp = fopen(patch_path, "wb")) == NULL) {
+        printf("Erreur: impossible d'écrire '%s'.\n", patch_path);
+        free(table);
+        free(o);
+        free(n);
+        return 1;
+    }
+    mask--;
+    memset(table, 0xff, (mask + 1) * sizeof(*table));
+    for (k = 0; k + DELTA_BLOCK <= on; k += DELTA_BLOCK) {
+        uint32_t *slot = &table[delta_hash(o + k) & mask];
+        if (*slot == UINT32_MAX) *slot = (uint32_t) k;
+    }
+    for (k = 1; k < DELTA_BLOCK; k++) pow *= 257;
+    fwrite(DELTA_MAGIC, 1, sizeof(DELTA_MAGIC) - 1, fp);
+
+    if (nn >= DELTA_BLOCK) h = delta_hash(n);
+    while (i + DELTA_BLOCK <= nn) {
+        size_t j = 0, len = 0;
+        long pred = (long) i + disp;
+
+        // Même décalage que la copie précédente, sinon un bloc indexé
+        if (pred >= 0 && (size_t) pred < on) {
+            j = (size_t) pred;
+            len = common_prefix(n + i, nn - i, o + j, on - j);
+        }
+        if (len < DELTA_MIN_COPY) {
+            uint32_t cand = table[h & mask];
+            len = 0;
+            if (cand != UINT32_MAX) {
+                j = cand;
+                len = common_prefix(n + i, nn - i, o + j, on - j);
+                if (len < DELTA_BLOCK) len = 0;
+            }
+        }
+        if (len >= DELTA_MIN_COPY) {
+            while (i > lit && j > 0 && n[i - 1] == o[j - 1]) i--, j--, len++;
+            delta_insert(fp, n + lit, i - lit);
+            fputc('C', fp);
+            delta_put_u32(fp, j);
+            delta_put_u32(fp, len);
+            copies++;
+            copied += len;
+            disp = (long) j - (long) i;
+            i += len;
+            lit = i;
+            if (i + DELTA_BLOCK <= nn) h = delta_hash(n + i);
+            continue;
+        }
+        if (i + DELTA_BLOCK < nn) h = (h - n[i] * pow) * 257 + n[i + DELTA_BLOCK];
+        i++;
+    }
+    delta_insert(fp, n + lit, nn - lit);
+
+    if (fclose(fp) != 0) {
+        printf("Erreur: impossible d'écrire '%s'.\n", patch_path);
+        free(table);
+        free(o);
+        free(n);
+        return 1;
+    }
+    {
+        struct stat st;
+        stat(patch_path, &st);
+        printf("%s : %lu octets pour %lu (%.1f %%), %lu copies couvrant %.0f %% du nouveau binaire.\n",
+               patch_path, (unsigned long) st.st_size, (unsigned long) nn,
+               nn > 0 ? 100.0 * (double) st.st_size / (double) nn : 0.0, (unsigned long) copies,
+               nn > 0 ? 100.0 * (double) copied / (double) nn : 0.0);
+    }
+    free(table);
+    free(o);
+    free(n);
+    return 0;
+}
+
+// Mise à jour depuis les sources : git pull puis make dans le dossier source
+static int update_from_source(const char *current_exe) {
+    // 1. Déterminer le dossier source
+    char source_dir[PATH_MAX];
+    const char *home = getenv("HOME");
+    int source_found = 0;
+
+    if (home) {
+        snprintf(source_dir, sizeof(source_dir), "%s/.wallchange_source", home);
+        if (access(source_dir, F_OK) == 0) {
+            source_found = 1;
+        }
+    }
+
+    // Fallback: dossier courant si Makefile présent
+    if (!source_found && access("Makefile", F_OK) == 0) {
+        if (getcwd(source_dir, sizeof(source_dir)) != NULL) {
+            source_found = 1;
+            printf("Utilisation du dossier courant comme source: %s\n", source_dir);
+        }
+    }
+
+    if (!source_found) {
+        fprintf(stderr, "Erreur: Impossible de localiser le dossier source (.wallchange_source ou dossier courant).\n");
+        return 0;
+    }
+
+    // 2. Se déplacer dans le dossier source
+    printf("Changement de répertoire vers %s\n", source_dir);
+    if (chdir(source_dir) != 0) {
+        perror("chdir failed");
+        return 0;
+    }
+    
+    // 3. Git pull
+    printf("Exécution de git pull...\n");
+    if (system("git pull") != 0) {
+        printf("Attention: git pull a échoué ou n'est pas nécessaire.\n");
+    }
+    
+    // 4. Recompile (make seul : "make re" supprimerait mongoose.c et cJSON.c)
+    printf("Recompilation...\n");
+    if (system("make") != 0) {
+        printf("Erreur lors de la compilation.\n");
+        return 0;
+    }
+    
+    // 5. Copier le nouveau binaire si nécessaire
+    char new_binary[PATH_MAX + 16];
+    snprintf(new_binary, sizeof(new_binary), "%s/wallchange", source_dir);
+    
+    // On compare les chemins
+    char *real_new = realpath(new_binary, NULL);
+    char *real_current = realpath(current_exe, NULL);
+    int ok = 1;
+
+    if (real_new && real_current && strcmp(real_new, real_current) != 0) {
+        char tmp[PATH_MAX];
+        int fd = update_temp(current_exe, tmp, sizeof(tmp));
+        char *cp_argv[] = {"cp", new_binary, tmp, NULL};
+
+        printf("Mise à jour du binaire installé: %s -> %s\n", new_binary, current_exe);
+        if (fd >= 0) close(fd);
+        // Copie à côté puis rename(), pour ne jamais laisser de binaire à moitié copié
+        if (fd < 0 || !run_program(cp_argv)) {
+            fprintf(stderr, "Erreur lors de la copie du binaire.\n");
+            if (fd >= 0) unlink(tmp);
+            ok = 0;
+        } else {
+            ok = install_binary(tmp, current_exe);
+        }
+    } else {
+        printf("Le binaire s'exécute déjà depuis la source ou chemins identiques.\n");
+    }
+    
+    if (real_new) free(real_new);
+    if (real_current) free(real_current);
+    return ok;
+}
+
+// Fonction de mise à jour automatique : binaire précompilé et signé si le
+// serveur en publie un, sinon recompilation depuis les sources. Avec une clé
+// configurée, un 404 ou une erreur réseau ne suffit pas à contourner la
+// signature : les sources ne sont utilisées que sur demande explicite
+void perform_update() {
+    uint64_t start = mg_millis();
+    int rc;
+
+    printf("Mise à jour demandée...\n");
+
+    // Sauvegarder le chemin de l'exécutable actuel
+    char current_exe[PATH_MAX];
+    ssize_t len = readlink("/proc/self/exe", current_exe, sizeof(current_exe) - 1);
+    if (len == -1) {
+        perror("readlink failed");
+        return;
+    }
+    current_exe[len] = '\0';
+
+    rc = update_prebuilt(current_exe);
+    if (rc == UPDATE_CURRENT || rc == UPDATE_REJECTED) return;
+    if (rc == UPDATE_UNAVAILABLE && UPDATE_PUBKEY[0] != '\0') {
+        const char *opt = getenv("WALLCHANGE_UPDATE_FROM_SOURCE");
+        if (opt == NULL || strcmp(opt, "1") != 0) {
+            printf("Mise à jour annulée : aucun binaire signé disponible, et la compilation "
+                   "depuis les sources demande WALLCHANGE_UPDATE_FROM_SOURCE=1.\n");
+            return;
+        }
+    }
+    if (rc == UPDATE_UNAVAILABLE && !update_from_source(current_exe)) return;
+
+    // Restart
+    printf("Mise à jour terminée en %.1f s. Redémarrage du client...\n",
+           (double) (mg_millis() - start) / 1000.0);
+    fflush(stdout);  // execv() perdrait ce qui reste dans le tampon
+    
+    char *args[] = {current_exe, NULL};
+    execv(current_exe, args);
+    
+    // Si execv échoue
+    perror("execv failed");
+}
+
+int main(int argc, char **argv) {
+    // Mode commande : envoi d'images
+    if (argc >= 2 && strcmp(argv[1], "send") == 0) {
+        struct send_opts opts = {SEND_DEFAULT_MAX_SIDE, SEND_DEFAULT_QUALITY, 0, NULL};
+        int i;
+        for (i = 2; i < argc && argv[i][0] == '-'; i++) {
+            if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--original") == 0) {
+                opts.original = 1;
+            } else if ((strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--max-size") == 0) && i + 1 < argc) {
+                opts.max_side = atoi(argv[++i]);
+            } else if ((strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quality") == 0) && i + 1 < argc) {
+                opts.quality = atoi(argv[++i]);
+            } else if ((strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "--list") == 0) && i + 1 < argc) {
+                opts.list_file = argv[++i];
+            } else {
+                break;
+            }
+        }
+        if (argc - i < (opts.list_file ? 1 : 2) || opts.max_side < 0 || opts.quality < 1 || opts.quality > 100) {
+            printf("Usage: %s send [-o|--original] [-s|--max-size pixels] [-q|--quality 1-100] [-l|--list fichier] "
+                   "<image|url|motif>... <utilisateur[,utilisateur...]>...\n", argv[0]);
+            return SEND_ERR_USAGE;
+        }
+        return send_command(argc - i, argv + i, &opts);
+    }
+
+    // Patch entre deux binaires, pour publier une mise à jour
+    if (argc >= 2 && strcmp(argv[1], "delta") == 0) {
+        if (argc != 5) {
+            printf("Usage: %s delta <ancien binaire> <nouveau binaire> <patch>\n", argv[0]);
+            return 1;
+        }
+        return delta_command(argv[2], argv[3], argv[4]);
     }
 
     mg_mgr_init(&mgr);
+    control_listen();
     
     // Premier essai
     connect_ws();
@@ -333,6 +2541,7 @@ int main(int argc, char **argv) {
 
     while (!interrupted) {
         mg_mgr_poll(&mgr, 100);
+        relay_expire(0);
 
         // Reconnexion automatique
         if (ws_conn == NULL) {
@@ -483,13 +483,21 @@ struct mg_connection *mg_mdns_listen(struct mg_mgr *mgr, char *name) {
 
 
 void mg_call(struct mg_connection *c, int ev, void *ev_data) {
+#if MG_ENABLE_METRICS
+  // Time outermost calls only: protocol handlers nest user events, e.g.
+  // MG_EV_WS_MSG inside MG_EV_READ. MG_EV_POLL is too frequent to time
+  struct mg_stats *st = &c->mgr->stats;
+  bool timed = ev != MG_EV_POLL && st->depth++ == 0;
+  uint64_t t0 = timed ? mg_micros() : 0;
+#endif
 #if MG_ENABLE_PROFILE
   const char *names[] = {
       "EV_ERROR",    "EV_OPEN",      "EV_POLL",      "EV_RESOLVE",
       "EV_CONNECT",  "EV_ACCEPT",    "EV_TLS_HS",    "EV_READ",
       "EV_WRITE",    "EV_CLOSE",     "EV_HTTP_MSG",  "EV_HTTP_CHUNK",
       "EV_WS_OPEN",  "EV_WS_MSG",    "EV_WS_CTL",    "EV_MQTT_CMD",
-      "EV_MQTT_MSG", "EV_MQTT_OPEN", "EV_SNTP_TIME", "EV_USER"};
+      "EV_MQTT_MSG", "EV_MQTT_OPEN", "EV_SNTP_TIME", "EV_WAKEUP",
+      "EV_SEND_HIGH", "EV_SEND_LOW", "EV_WS_FILE", "EV_USER"};
   if (ev != MG_EV_POLL && ev < (int) (sizeof(names) / sizeof(names[0]))) {
     MG_PROF_ADD(c, names[ev]);
   }
@@ -497,6 +505,15 @@ void mg_call(struct mg_connection *c, int ev, void *ev_data) {
   // Fire protocol handler first, user handler second. See #2559
   if (c->pfn != NULL) c->pfn(c, ev, ev_data);
   if (c->fn != NULL) c->fn(c, ev, ev_data);
+#if MG_ENABLE_METRICS
+  if (ev != MG_EV_POLL) st->depth--;
+  if (timed) {
+    uint64_t us = mg_micros() - t0;
+    c->stats.handler_us += us;
+    st->handler_us += us;
+    mg_stats_hist(st->handler_hist, us);
+  }
+#endif
 }
 
 void mg_error(struct mg_connection *c, const char *fmt, ...) {
@@ -2551,6 +2568,7 @@ static void http_cb(struct mg_connection *c, int ev, void *ev_data) {
       }
 
       if (c->is_accepted) c->is_resp = 1;  // Start generating response
+      MG_STATS_ADD(c, frames_in, 1);
       mg_call(c, MG_EV_HTTP_MSG, &hm);     // User handler can clear is_resp
       if (c->is_accepted && !c->is_resp) {
         struct mg_str *cc = mg_http_get_header(&hm, "Connection");
@@ -2956,6 +2974,9 @@ bool mg_json_unescape(struct mg_str s, char *to, size_t n) {
                         sizeof(uint8_t)) == false)
         return false;
       i += 5;
+    } else if (s.buf[i] == '\\' && i + 1 < s.len && s.buf[i + 1] == '/') {
+      to[j] = '/';  // Escaped solidus, e.g. from PHP json_encode()
+      i++;
     } else if (s.buf[i] == '\\' && i + 1 < s.len) {
       char c = json_esc(s.buf[i + 1], 0);
       if (c == 0) return false;
@@ -3301,6 +3322,155 @@ void mg_md5_final(mg_md5_ctx *ctx, unsigned char digest[16]) {
 }
 #endif
 
+#ifdef MG_ENABLE_LINES
+#line 1 "src/metrics.c"
+#endif
+
+
+
+#if MG_ENABLE_METRICS
+void mg_stats_hist(uint32_t *hist, uint64_t us) {
+  size_t i = 0;
+  while (i < MG_STATS_BUCKETS - 1 && us >= ((uint64_t) 1 << i)) i++;
+  hist[i]++;
+}
+
+void mg_stats_fold(struct mg_stats *s, const struct mg_conn_stats *cs) {
+  s->bytes_in += cs->bytes_in, s->bytes_out += cs->bytes_out;
+  s->frames_in += cs->frames_in, s->frames_out += cs->frames_out;
+  s->tls_in += cs->tls_in, s->tls_out += cs->tls_out;
+  s->allocs += cs->allocs;
+}
+#endif
+
+void mg_mgr_stats(struct mg_mgr *mgr, struct mg_stats *s) {
+  struct mg_connection *c;
+  *s = mgr->stats;
+  s->accepts = mgr->accepts;
+  s->active = 0, s->depth = 0;
+  for (c = mgr->conns; c != NULL; c = c->next) {
+#if MG_ENABLE_METRICS
+    mg_stats_fold(s, &c->stats);
+#endif
+    s->active++;
+  }
+}
+
+static size_t print_hist(void (*out)(char, void *), void *arg,
+                         const uint32_t *hist) {
+  size_t i, n = 0;
+  for (i = 0; i < MG_STATS_BUCKETS; i++) {
+    n += mg_xprintf(out, arg, "%s%lu", i == 0 ? "" : ",",
+                    (unsigned long) hist[i]);
+  }
+  return n;
+}
+
+// Print struct mg_stats * as JSON. Histogram arrays are indexed by bucket
+size_t mg_print_stats_json(void (*out)(char, void *), void *arg, va_list *ap) {
+  struct mg_stats *s = va_arg(*ap, struct mg_stats *);
+  size_t n = mg_xprintf(
+      out, arg,
+      "{%m:%llu,%m:%llu,%m:%lu,%m:%llu,%m:%llu,%m:%llu,%m:%llu,%m:%llu,"
+      "%m:%llu,%m:%llu,%m:%llu,%m:%llu,%m:[",
+      MG_ESC("opened"), s->opened, MG_ESC("closed"), s->closed,
+      MG_ESC("active"), s->active, MG_ESC("bytes_in"), s->bytes_in,
+      MG_ESC("bytes_out"), s->bytes_out, MG_ESC("frames_in"), s->frames_in,
+      MG_ESC("frames_out"), s->frames_out, MG_ESC("tls_in"), s->tls_in,
+      MG_ESC("tls_out"), s->tls_out, MG_ESC("allocs"), s->allocs,
+      MG_ESC("handler_us"), s->handler_us, MG_ESC("poll_us"), s->poll_us,
+      MG_ESC("handler_hist"));
+  n += print_hist(out, arg, s->handler_hist);
+  n += mg_xprintf(out, arg, "],%m:[", MG_ESC("poll_hist"));
+  n += print_hist(out, arg, s->poll_hist);
+  n += mg_xprintf(
+      out, arg, "],%m:{%m:%llu,%m:%llu,%m:%llu,%m:%llu,%m:%lu,%m:%lu}}",
+      MG_ESC("accepts"), MG_ESC("accepted"), s->accepts.accepted,
+      MG_ESC("failed"), s->accepts.failed, MG_ESC("budget_hits"),
+      s->accepts.budget_hits, MG_ESC("full_samples"), s->accepts.full_samples,
+      MG_ESC("peak_backlog"), s->accepts.peak_backlog, MG_ESC("rate"),
+      s->accepts.rate);
+  return n;
+}
+
+static size_t print_prom_hist(void (*out)(char, void *), void *arg,
+                              const char *name, const uint32_t *hist,
+                              uint64_t sum_us) {
+  size_t i, n = 0;
+  uint64_t total = 0;
+  n += mg_xprintf(out, arg, "# TYPE %s histogram\n", name);
+  for (i = 0; i < MG_STATS_BUCKETS; i++) {
+    total += hist[i];
+    if (i < MG_STATS_BUCKETS - 1) {
+      n += mg_xprintf(out, arg, "%s_bucket{le=\"%g\"} %llu\n", name,
+                      (double) ((uint64_t) 1 << i) / 1e6, total);
+    } else {
+      n += mg_xprintf(out, arg, "%s_bucket{le=\"+Inf\"} %llu\n", name, total);
+    }
+  }
+  n += mg_xprintf(out, arg, "%s_sum %llu.%06llu\n%s_count %llu\n", name,
+                  sum_us / 1000000, sum_us % 1000000, name, total);
+  return n;
+}
+
+// Print struct mg_stats * in the Prometheus text exposition format
+size_t mg_print_stats_prom(void (*out)(char, void *), void *arg, va_list *ap) {
+  struct mg_stats *s = va_arg(*ap, struct mg_stats *);
+  struct {
+    const char *name;
+    uint64_t value;
+  } counters[] = {
+      {"mg_connections_opened_total", s->opened},
+      {"mg_connections_closed_total", s->closed},
+      {"mg_received_bytes_total", s->bytes_in},
+      {"mg_sent_bytes_total", s->bytes_out},
+      {"mg_received_frames_total", s->frames_in},
+      {"mg_sent_frames_total", s->frames_out},
+      {"mg_received_tls_records_total", s->tls_in},
+      {"mg_sent_tls_records_total", s->tls_out},
+      {"mg_buffer_allocations_total", s->allocs},
+      {"mg_accepted_connections_total", s->accepts.accepted},
+      {"mg_accept_errors_total", s->accepts.failed},
+      {"mg_accept_budget_hits_total", s->accepts.budget_hits},
+      {"mg_listen_queue_full_samples_total", s->accepts.full_samples},
+  };
+  size_t i, n = 0;
+  for (i = 0; i < sizeof(counters) / sizeof(counters[0]); i++) {
+    n += mg_xprintf(out, arg, "# TYPE %s counter\n%s %llu\n", counters[i].name,
+                    counters[i].name, counters[i].value);
+  }
+  n += mg_xprintf(out, arg, "# TYPE mg_connections gauge\nmg_connections %lu\n",
+                  s->active);
+  n += mg_xprintf(out, arg,
+                  "# TYPE mg_listen_queue_peak gauge\nmg_listen_queue_peak %lu\n"
+                  "# TYPE mg_accepts_per_second gauge\nmg_accepts_per_second %lu\n",
+                  s->accepts.peak_backlog, s->accepts.rate);
+  n += print_prom_hist(out, arg, "mg_handler_seconds", s->handler_hist,
+                       s->handler_us);
+  n += print_prom_hist(out, arg, "mg_poll_seconds", s->poll_hist, s->poll_us);
+  return n;
+}
+
+// Print the counters of struct mg_connection * as JSON
+size_t mg_print_conn_stats(void (*out)(char, void *), void *arg, va_list *ap) {
+  struct mg_connection *c = va_arg(*ap, struct mg_connection *);
+#if MG_ENABLE_METRICS
+  const struct mg_conn_stats *s = &c->stats;
+  return mg_xprintf(
+      out, arg,
+      "{%m:%lu,%m:%llu,%m:%llu,%m:%lu,%m:%lu,%m:%lu,%m:%lu,%m:%lu,%m:%llu}",
+      MG_ESC("id"), c->id, MG_ESC("bytes_in"), s->bytes_in,
+      MG_ESC("bytes_out"), s->bytes_out, MG_ESC("frames_in"),
+      (unsigned long) s->frames_in, MG_ESC("frames_out"),
+      (unsigned long) s->frames_out, MG_ESC("tls_in"),
+      (unsigned long) s->tls_in, MG_ESC("tls_out"), (unsigned long) s->tls_out,
+      MG_ESC("allocs"), (unsigned long) s->allocs, MG_ESC("handler_us"),
+      s->handler_us);
+#else
+  return mg_xprintf(out, arg, "{%m:%lu}", MG_ESC("id"), c->id);
+#endif
+}
+
 #ifdef MG_ENABLE_LINES
 #line 1 "src/mqtt.c"
 #endif
@@ -3907,9 +4077,18 @@ struct mg_connection *mg_mqtt_listen(struct mg_mgr *mgr, const char *url,
 
 
 size_t mg_vprintf(struct mg_connection *c, const char *fmt, va_list *ap) {
-  size_t old = c->send.len;
-  size_t expected = mg_vxprintf(mg_pfn_iobuf, &c->send, fmt, ap);
-  size_t actual = c->send.len - old;
+  size_t old = c->send.len, expected, actual;
+  if (c->send_high > 0) {
+    // Format aside, so that mg_send() applies the send limits to all of it
+    struct mg_iobuf io = {0, 0, 0, 256};
+    expected = mg_vxprintf(mg_pfn_iobuf, &io, fmt, ap);
+    actual = io.len == expected && mg_send(c, io.buf, io.len) ? io.len : 0;
+    if (io.len != expected) mg_error(c, "OOM");
+    mg_iobuf_free(&io);
+    return actual;
+  }
+  expected = mg_vxprintf(mg_pfn_iobuf, &c->send, fmt, ap);
+  actual = c->send.len - old;
   if (actual != expected) {
     mg_error(c, "OOM");
     c->send.len = old;
@@ -3927,6 +4106,91 @@ size_t mg_printf(struct mg_connection *c, const char *fmt, ...) {
   return len;
 }
 
+void mg_send_limits(struct mg_connection *c, size_t low, size_t high,
+                    int policy) {
+  if (high > 0xffffffffUL) high = 0xffffffffUL;
+  if (low > high) low = high;
+  c->send_high = (uint32_t) high;
+  c->send_low = (uint32_t) low;
+  c->send_policy = (unsigned) policy & 3U;
+  c->send_head = (uint32_t) c->send.len;  // Already queued data is kept
+  c->is_send_high = 0;
+}
+
+// Spill state of a connection, see mg_recv_limits()
+struct mg_spill {
+  char dir[MG_PATH_MAX];   // Where spill files are created
+  char path[MG_PATH_MAX];  // Current spill file
+  size_t threshold;        // Payloads longer than this go to a file
+  void *fd;                // Current spill file, NULL if none
+  size_t size;             // Payload bytes written so far
+  size_t left;             // Bytes of the current frame still to come
+  size_t pos;              // Position in the current frame, for unmasking
+  uint8_t mask[4];         // Masking key of the current frame, if masked
+  uint8_t flags;           // Flags of the first frame of the message
+  bool in_frame;           // A frame is being written
+  bool masked;
+  bool fin;                // The current frame ends the message
+};
+
+bool mg_recv_limits(struct mg_connection *c, size_t max, size_t spill,
+                    const char *dir) {
+  if (max > 0xffffffffUL) max = 0xffffffffUL;
+  c->recv_max = (uint32_t) max;
+  if (spill == 0) {
+    mg_spill_free(c);
+    return true;
+  }
+  if (c->spill == NULL &&
+      (c->spill = (struct mg_spill *) mg_calloc(1, sizeof(*c->spill))) ==
+          NULL) {
+    return false;
+  }
+  mg_snprintf(c->spill->dir, sizeof(c->spill->dir), "%s",
+              dir == NULL || dir[0] == '\0' ? "." : dir);
+  c->spill->threshold = spill;
+  return true;
+}
+
+void mg_spill_free(struct mg_connection *c) {
+  if (c->spill == NULL) return;
+  if (c->spill->fd != NULL) {
+    mg_fs_posix.cl(c->spill->fd);
+    mg_fs_posix.rm(c->spill->path);
+  }
+  mg_free(c->spill);
+  c->spill = NULL;
+}
+
+// Apply the send limits before queueing len bytes.
+// Return true if the data can be appended to c->send
+bool mg_send_room(struct mg_connection *c, size_t len) {
+  if (c->send_high == 0 || c->send.len + len <= c->send_high) return true;
+  if (c->is_closing) return false;
+  if (!c->is_send_high) {
+    c->is_send_high = 1;
+    mg_call(c, MG_EV_SEND_HIGH, NULL);
+  }
+  if (c->send_policy == MG_SEND_DISCONNECT) {
+    mg_error(c, "slow consumer, %lu bytes queued", (unsigned long) c->send.len);
+  } else if (c->send_policy == MG_SEND_DROP_OLDEST && c->is_websocket) {
+    mg_ws_drop(c, len);
+  }
+  return !c->is_closing && c->send.len + len <= c->send_high;
+}
+
+// Remove len bytes written to the network from the head of c->send
+void mg_send_del(struct mg_connection *c, size_t len) {
+  if (c->send_policy == MG_SEND_DROP_OLDEST && c->is_websocket) {
+    mg_ws_sent(c, len);
+  }
+  mg_iobuf_del(&c->send, 0, len);
+  if (c->is_send_high && c->send.len <= c->send_low) {
+    c->is_send_high = 0;
+    mg_call(c, MG_EV_SEND_LOW, NULL);
+  }
+}
+
 static bool mg_atonl(struct mg_str str, struct mg_addr *addr) {
   uint32_t localhost = mg_htonl(0x7f000001);
   if (mg_strcasecmp(str, mg_str("localhost")) != 0) return false;
@@ -4036,6 +4300,10 @@ struct mg_connection *mg_alloc_conn(struct mg_mgr *mgr) {
     c->mgr = mgr;
     c->send.align = c->recv.align = c->rtls.align = MG_IO_SIZE;
     c->id = ++mgr->nextid;
+    mgr->stats.opened++;
+#if MG_ENABLE_IDLE_RELEASE
+    c->io_ms = (uint32_t) mg_millis();
+#endif
     MG_PROF_INIT(c);
   }
   return c;
@@ -4052,8 +4320,13 @@ void mg_close_conn(struct mg_connection *c) {
   MG_DEBUG(("%lu %ld closed", c->id, c->fd));
   MG_PROF_DUMP(c);
   MG_PROF_FREE(c);
+#if MG_ENABLE_METRICS
+  mg_stats_fold(&c->mgr->stats, &c->stats);
+  c->mgr->stats.closed++;
+#endif
 
   mg_tls_free(c);
+  mg_spill_free(c);
   mg_iobuf_free(&c->recv);
   mg_iobuf_free(&c->send);
   mg_iobuf_free(&c->rtls);
@@ -4159,6 +4432,9 @@ void mg_mgr_free(struct mg_mgr *mgr) {
   MG_DEBUG(("All connections closed"));
 #if MG_ENABLE_EPOLL
   if (mgr->epoll_fd >= 0) close(mgr->epoll_fd), mgr->epoll_fd = -1;
+#endif
+#if MG_ENABLE_IO_URING
+  mg_uring_free(mgr);
 #endif
   mg_tls_ctx_free(mgr);
 #if MG_ENABLE_TCPIP
@@ -4174,6 +4450,9 @@ void mg_mgr_init(struct mg_mgr *mgr) {
 #else
   mgr->epoll_fd = -1;
 #endif
+#if MG_ENABLE_IO_URING
+  if (!mg_uring_init(mgr)) MG_ERROR(("io_uring unavailable, using poll()"));
+#endif
 #if MG_ARCH == MG_ARCH_WIN32 && MG_ENABLE_WINSOCK
   // clang-format off
   { WSADATA data; WSAStartup(MAKEWORD(2, 2), &data); }
@@ -5143,7 +5422,7 @@ static bool rx_udp(struct mg_tcpip_if *ifp, struct pkt *pkt) {
     c->rem.ip4 = pkt->ip->src;
   }
   memcpy(s->mac, pkt->eth->src, sizeof(s->mac));
-  if (c->recv.len >= MG_MAX_RECV_SIZE) {
+  if (c->recv.len >= MG_RECV_MAX(c)) {
     mg_error(c, "max_recv_buf_size reached");
   } else if (c->recv.size - c->recv.len < pkt->pay.len &&
              !mg_iobuf_resize(&c->recv, c->recv.len + pkt->pay.len)) {
@@ -5363,12 +5642,13 @@ long mg_io_send(struct mg_connection *c, const void *buf, size_t len) {
       if (s->ttype == MIP_TTYPE_ACK) settmout(c, MIP_TTYPE_KEEPALIVE);
     }
   }
+  MG_STATS_ADD(c, bytes_out, len);
   return (long) len;
 }
 
 static void handle_tls_recv(struct mg_connection *c) {
   size_t avail = mg_tls_pending(c);
-  size_t min = avail > MG_MAX_RECV_SIZE ? MG_MAX_RECV_SIZE : avail;
+  size_t min = avail > MG_RECV_MAX(c) ? MG_RECV_MAX(c) : avail;
   struct mg_iobuf *io = &c->recv;
   if (io->size - io->len < min && !mg_iobuf_resize(io, io->len + min)) {
     mg_error(c, "oom");
@@ -5389,6 +5669,7 @@ static void handle_tls_recv(struct mg_connection *c) {
 static void read_conn(struct mg_connection *c, struct pkt *pkt) {
   struct connstate *s = (struct connstate *) (c + 1);
   struct mg_iobuf *io = c->is_tls ? &c->rtls : &c->recv;
+  size_t size = io->size;
   uint32_t seq = mg_ntohl(pkt->tcp->seq);
   if (pkt->tcp->flags & TH_FIN) {
     uint8_t flags = TH_ACK;
@@ -5449,6 +5730,8 @@ static void read_conn(struct mg_connection *c, struct pkt *pkt) {
   // call back mg_io_recv() which grabs raw data from c->rtls
   memcpy(&io->buf[io->len], pkt->pay.buf, pkt->pay.len);
   io->len += pkt->pay.len;
+  MG_STATS_ADD(c, bytes_in, pkt->pay.len);
+  if (io->size != size) MG_STATS_ADD(c, allocs, 1);
   MG_VERBOSE(("%lu SEQ %x -> %x", c->id, mg_htonl(pkt->tcp->seq), s->ack));
   // Advance ACK counter
   s->ack = (uint32_t) (mg_htonl(pkt->tcp->seq) + pkt->pay.len);
@@ -6150,7 +6433,7 @@ static void write_conn(struct mg_connection *c) {
   if (len == MG_IO_ERR) {
     mg_error(c, "tx err");
   } else if (len > 0) {
-    mg_iobuf_del(&c->send, 0, (size_t) len);
+    mg_send_del(c, (size_t) len);
     mg_call(c, MG_EV_WRITE, &len);
   }
 }
@@ -6224,8 +6507,12 @@ bool mg_send(struct mg_connection *c, const void *buf, size_t len) {
   } else if (c->is_udp) {
     len = trim_len(c, len);  // Trimming length if necessary
     res = udp_send(c, buf, len);
+  } else if (len > 0 && !mg_send_room(c, len)) {
+    // Backpressure, see mg_send_limits()
   } else {
+    size_t size = c->send.size;
     res = len == 0 || mg_iobuf_add(&c->send, c->send.len, buf, len) > 0;
+    if (c->send.size != size) MG_STATS_ADD(c, allocs, 1);
     // returning 0 means an OOM condition (iobuf couldn't resize), yet this is
     // so far recoverable, let the caller decide
   }
@@ -9547,7 +9834,7 @@ static void iolog(struct mg_connection *c, char *buf, long n, bool r) {
       c->recv.len += (size_t) n;
       mg_call(c, MG_EV_READ, &n);
     } else {
-      mg_iobuf_del(&c->send, 0, (size_t) n);
+      mg_send_del(c, (size_t) n);
       // if (c->send.len == 0) mg_iobuf_resize(&c->send, 0);
       if (c->send.len == 0) {
         MG_EPOLL_MOD(c, 0);
@@ -9571,6 +9858,7 @@ long mg_io_send(struct mg_connection *c, const void *buf, size_t len) {
   if (MG_SOCK_PENDING(n)) return MG_IO_WAIT;
   if (MG_SOCK_RESET(n)) return MG_IO_RESET;  // MbedTLS, see #1507
   if (n <= 0) return MG_IO_ERR;
+  MG_STATS_ADD(c, bytes_out, (uint64_t) n);
   return n;
 }
 
@@ -9581,10 +9869,15 @@ bool mg_send(struct mg_connection *c, const void *buf, size_t len) {
               c->recv.len, c->rtls.len, n, MG_SOCK_ERR(n)));
     iolog(c, (char *) buf, n, false);
     return n > 0;
+  } else if (len > 0 && !mg_send_room(c, len)) {
+    return false;  // Backpressure, see mg_send_limits()
   } else {
-    return len == 0 || mg_iobuf_add(&c->send, c->send.len, buf, len) > 0;
+    size_t size = c->send.size;
     // returning 0 means an OOM condition (iobuf couldn't resize), yet this is
     // so far recoverable, let the caller decide
+    bool res = len == 0 || mg_iobuf_add(&c->send, c->send.len, buf, len) > 0;
+    if (c->send.size != size) MG_STATS_ADD(c, allocs, 1);
+    return res;
   }
 }
 
@@ -9645,9 +9938,44 @@ void mg_multicast_add(struct mg_connection *c, char *ip) {
 #endif
 }
 
+#if MG_ARCH == MG_ARCH_UNIX
+// "unix:///path/to/socket": local stream socket. The path must not exist,
+// removing a stale socket file is up to the caller
+static bool open_unix_listener(struct mg_connection *c, const char *path) {
+  MG_SOCKET_TYPE fd = MG_INVALID_SOCKET;
+  struct sockaddr_un sun;
+  size_t len = strlen(path);
+  bool success = false;
+  if (len == 0 || len >= sizeof(sun.sun_path)) {
+    MG_ERROR(("invalid socket path: %s", path));
+    return false;
+  }
+  memset(&sun, 0, sizeof(sun));
+  sun.sun_family = AF_UNIX;
+  memcpy(sun.sun_path, path, len);
+  if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == MG_INVALID_SOCKET) {
+    MG_ERROR(("socket: %d", MG_SOCK_ERR(-1)));
+  } else if (bind(fd, (struct sockaddr *) &sun, sizeof(sun)) != 0) {
+    MG_ERROR(("bind(%s): %d", path, MG_SOCK_ERR(-1)));
+  } else if (listen(fd, MG_SOCK_LISTEN_BACKLOG_SIZE) != 0) {
+    MG_ERROR(("listen: %d", MG_SOCK_ERR(-1)));
+  } else {
+    mg_set_non_blocking_mode(fd);
+    c->fd = S2PTR(fd);
+    MG_EPOLL_ADD(c);
+    success = true;
+  }
+  if (success == false && fd != MG_INVALID_SOCKET) closesocket(fd);
+  return success;
+}
+#endif
+
 bool mg_open_listener(struct mg_connection *c, const char *url) {
   MG_SOCKET_TYPE fd = MG_INVALID_SOCKET;
   bool success = false;
+#if MG_ARCH == MG_ARCH_UNIX
+  if (strncmp(url, "unix://", 7) == 0) return open_unix_listener(c, url + 7);
+#endif
   c->loc.port = mg_htons(mg_url_port(url));
   if (!mg_aton(mg_url_host(url), &c->loc)) {
     MG_ERROR(("invalid listening URL: %s", url));
@@ -9707,8 +10035,230 @@ bool mg_open_listener(struct mg_connection *c, const char *url) {
   return success;
 }
 
+#if MG_ENABLE_IO_URING
+// io_uring backend. Listeners use multishot accept, TCP connections use
+// multishot recv into a ring of kernel-provided buffers. Received bytes are
+// staged in c->rtls: TLS already reads raw data from there, and for plain
+// connections read_conn() moves them to c->recv. Writes, connects and UDP
+// keep using plain syscalls, woken up by one-shot poll requests. Everything
+// queued during one mg_mgr_poll() is submitted by a single io_uring_enter()
+enum {
+  MG_URING_ACCEPT = 1,
+  MG_URING_RECV,
+  MG_URING_POLLIN,
+  MG_URING_POLLOUT,
+  MG_URING_CANCEL
+};
+
+enum {
+  MG_URING_ARMED = 1,    // Multishot accept or recv is active
+  MG_URING_ARMED_IN = 2,   // POLLIN request is active
+  MG_URING_ARMED_OUT = 4,  // POLLOUT request is active
+  MG_URING_EOF = 8,      // Peer closed, or recv failed
+  MG_URING_NEW = 16      // New data staged since last read_conn()
+};
+
+struct mg_uring_slot {
+  struct mg_connection *c;  // Connection owning this socket
+  unsigned flags;           // MG_URING_* flags
+};
+
+struct mg_uring {
+  int fd;                         // Ring file descriptor
+  unsigned sq_entries;            // Submission queue size
+  unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;  // Submission ring
+  unsigned *cq_head, *cq_tail, *cq_mask;             // Completion ring
+  struct io_uring_sqe *sqes;      // Submission entries
+  struct io_uring_cqe *cqes;      // Completion entries
+  void *sq_ptr, *cq_ptr;          // Mapped rings
+  size_t sq_size, cq_size, sqes_size;
+  struct io_uring_buf_ring *br;   // Provided buffer ring
+  size_t br_size;                 // Size of the mapped buffer ring
+  unsigned short br_tail;         // Our copy of the buffer ring tail
+  unsigned char *bufs;            // MG_IO_URING_BUFS * MG_IO_URING_BUF_SIZE
+  struct mg_uring_slot *slots;    // Indexed by socket descriptor
+  size_t nslots;                  // Number of allocated slots
+};
+
+// user_data layout: 4 bits op, 24 bits socket, 36 bits of connection ID.
+// The ID lets us drop late completions for a socket number that got reused
+#define MG_URING_UD(op, c) \
+  ((uint64_t) (op) | ((uint64_t) FD(c) << 4) | ((uint64_t) (c)->id << 28))
+
+static int uring_enter(struct mg_uring *u, unsigned wait, int ms) {
+  struct io_uring_getevents_arg arg;
+  struct __kernel_timespec ts;
+  unsigned flags = 0;
+  unsigned n = *u->sq_tail - __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE);
+  memset(&arg, 0, sizeof(arg));
+  if (wait > 0) {
+    flags |= IORING_ENTER_GETEVENTS;
+    if (ms >= 0) {
+      ts.tv_sec = ms / 1000, ts.tv_nsec = (long long) (ms % 1000) * 1000000;
+      arg.ts = (uint64_t) (size_t) &ts;
+      flags |= IORING_ENTER_EXT_ARG;
+    }
+  }
+  if (n == 0 && flags == 0) return 0;
+  return (int) syscall(__NR_io_uring_enter, u->fd, n, wait, flags,
+                       flags & IORING_ENTER_EXT_ARG ? &arg : NULL,
+                       sizeof(arg));
+}
+
+static struct io_uring_sqe *uring_sqe(struct mg_uring *u, uint64_t ud) {
+  unsigned tail = *u->sq_tail, i = tail & *u->sq_mask;
+  struct io_uring_sqe *sqe;
+  if (tail - __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE) >= u->sq_entries) {
+    uring_enter(u, 0, 0);  // Submission queue is full, flush it
+    if (tail - __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE) >= u->sq_entries)
+      return NULL;
+  }
+  sqe = &u->sqes[i];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data = ud;
+  u->sq_array[i] = i;
+  __atomic_store_n(u->sq_tail, tail + 1, __ATOMIC_RELEASE);
+  return sqe;
+}
+
+static void uring_buf_put(struct mg_uring *u, unsigned short bid) {
+  struct io_uring_buf *b = &u->br->bufs[u->br_tail & (MG_IO_URING_BUFS - 1)];
+  // Do not memset: bufs[0].resv overlaps with the ring tail
+  b->addr = (uint64_t) (size_t) &u->bufs[(size_t) bid * MG_IO_URING_BUF_SIZE];
+  b->len = MG_IO_URING_BUF_SIZE;
+  b->bid = bid;
+  __atomic_store_n(&u->br->tail, ++u->br_tail, __ATOMIC_RELEASE);
+}
+
+static struct mg_uring_slot *uring_slot(struct mg_uring *u,
+                                        struct mg_connection *c) {
+  size_t fd = (size_t) FD(c);
+  if (fd >= u->nslots) {
+    size_t n = u->nslots == 0 ? 1024 : u->nslots;
+    struct mg_uring_slot *p;
+    while (n <= fd) n *= 2;
+    if ((p = (struct mg_uring_slot *) mg_calloc(n, sizeof(*p))) == NULL) {
+      return NULL;
+    }
+    if (u->slots != NULL) memcpy(p, u->slots, u->nslots * sizeof(*p));
+    mg_free(u->slots);
+    u->slots = p, u->nslots = n;
+  }
+  if (u->slots[fd].c != c) u->slots[fd].c = c, u->slots[fd].flags = 0;
+  return &u->slots[fd];
+}
+
+static bool uring_eof(struct mg_connection *c) {
+  struct mg_uring *u = (struct mg_uring *) c->mgr->uring;
+  size_t fd = (size_t) FD(c);
+  return fd < u->nslots && u->slots[fd].c == c &&
+         (u->slots[fd].flags & MG_URING_EOF);
+}
+
+// Cancel all requests for a socket that is about to be closed. Submit right
+// away, before the descriptor gets closed and reused
+static void uring_forget(struct mg_connection *c) {
+  struct mg_uring *u = (struct mg_uring *) c->mgr->uring;
+  size_t fd = (size_t) FD(c);
+  struct io_uring_sqe *sqe;
+  if (u == NULL || fd >= u->nslots || u->slots[fd].c != c) return;
+  if (u->slots[fd].flags & (MG_URING_ARMED | MG_URING_ARMED_IN |
+                            MG_URING_ARMED_OUT)) {
+    if ((sqe = uring_sqe(u, MG_URING_UD(MG_URING_CANCEL, c))) != NULL) {
+      sqe->opcode = IORING_OP_ASYNC_CANCEL;
+      sqe->fd = (int) fd;
+      sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+      uring_enter(u, 0, 0);
+    }
+  }
+  u->slots[fd].c = NULL, u->slots[fd].flags = 0;
+}
+
+void mg_uring_free(struct mg_mgr *mgr) {
+  struct mg_uring *u = (struct mg_uring *) mgr->uring;
+  if (u == NULL) return;
+  if (u->fd >= 0) close(u->fd);
+  if (u->sq_ptr != NULL) munmap(u->sq_ptr, u->sq_size);
+  if (u->cq_ptr != NULL) munmap(u->cq_ptr, u->cq_size);
+  if (u->sqes != NULL) munmap(u->sqes, u->sqes_size);
+  if (u->br != NULL) munmap(u->br, u->br_size);
+  mg_free(u->bufs);
+  mg_free(u->slots);
+  mg_free(u);
+  mgr->uring = NULL;
+}
+
+bool mg_uring_init(struct mg_mgr *mgr) {
+  struct mg_uring *u = (struct mg_uring *) mg_calloc(1, sizeof(*u));
+  struct io_uring_params p;
+  struct io_uring_buf_reg reg;
+  unsigned i;
+  if ((mgr->uring = u) == NULL) return false;
+  memset(&p, 0, sizeof(p));
+  p.flags = IORING_SETUP_CQSIZE;  // Multishot requests produce many CQEs
+  p.cq_entries = MG_IO_URING_ENTRIES * 4;
+  u->fd = (int) syscall(__NR_io_uring_setup, MG_IO_URING_ENTRIES, &p);
+  if (u->fd < 0 || !(p.features & IORING_FEAT_EXT_ARG)) goto fail;
+  u->sq_entries = p.sq_entries;
+  u->sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  u->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  u->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+  u->sq_ptr = mmap(NULL, u->sq_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQ_RING);
+  u->cq_ptr = mmap(NULL, u->cq_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_CQ_RING);
+  u->sqes = (struct io_uring_sqe *) mmap(NULL, u->sqes_size,
+                                         PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_POPULATE, u->fd,
+                                         IORING_OFF_SQES);
+  if (u->sq_ptr == MAP_FAILED) u->sq_ptr = NULL;
+  if (u->cq_ptr == MAP_FAILED) u->cq_ptr = NULL;
+  if ((void *) u->sqes == MAP_FAILED) u->sqes = NULL;
+  if (u->sq_ptr == NULL || u->cq_ptr == NULL || u->sqes == NULL) goto fail;
+  u->sq_head = (unsigned *) ((char *) u->sq_ptr + p.sq_off.head);
+  u->sq_tail = (unsigned *) ((char *) u->sq_ptr + p.sq_off.tail);
+  u->sq_mask = (unsigned *) ((char *) u->sq_ptr + p.sq_off.ring_mask);
+  u->sq_array = (unsigned *) ((char *) u->sq_ptr + p.sq_off.array);
+  u->cq_head = (unsigned *) ((char *) u->cq_ptr + p.cq_off.head);
+  u->cq_tail = (unsigned *) ((char *) u->cq_ptr + p.cq_off.tail);
+  u->cq_mask = (unsigned *) ((char *) u->cq_ptr + p.cq_off.ring_mask);
+  u->cqes = (struct io_uring_cqe *) ((char *) u->cq_ptr + p.cq_off.cqes);
+
+  // Provided buffer ring, group 0. Requires Linux 5.19+
+  u->br_size = MG_IO_URING_BUFS * sizeof(struct io_uring_buf);
+  u->br = (struct io_uring_buf_ring *) mmap(NULL, u->br_size,
+                                            PROT_READ | PROT_WRITE,
+                                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if ((void *) u->br == MAP_FAILED) u->br = NULL;
+  u->bufs = (unsigned char *) mg_calloc(MG_IO_URING_BUFS, MG_IO_URING_BUF_SIZE);
+  if (u->br == NULL || u->bufs == NULL) goto fail;
+  memset(&reg, 0, sizeof(reg));
+  reg.ring_addr = (uint64_t) (size_t) u->br;
+  reg.ring_entries = MG_IO_URING_BUFS;
+  if (syscall(__NR_io_uring_register, u->fd, IORING_REGISTER_PBUF_RING, &reg,
+              1) != 0) {
+    goto fail;
+  }
+  for (i = 0; i < MG_IO_URING_BUFS; i++) uring_buf_put(u, (unsigned short) i);
+  MG_DEBUG(("io_uring fd %d, %u entries, %u x %u buffers", u->fd,
+            u->sq_entries, MG_IO_URING_BUFS, MG_IO_URING_BUF_SIZE));
+  return true;
+fail:
+  MG_ERROR(("io_uring setup failed, errno %d", errno));
+  mg_uring_free(mgr);
+  return false;
+}
+#endif
+
 static long recv_raw(struct mg_connection *c, void *buf, size_t len) {
   long n = 0;
+#if MG_ENABLE_IO_URING
+  if (c->mgr->uring != NULL && !c->is_udp) {
+    // Data has been already staged in c->rtls by the multishot recv
+    if (!c->is_tls && c->rtls.len > 0) return mg_io_recv(c, buf, len);
+    return uring_eof(c) ? MG_IO_ERR : MG_IO_WAIT;
+  }
+#endif
   if (c->is_udp) {
     union usa usa;
     socklen_t slen = tousa(&c->rem, &usa);
@@ -9721,17 +10271,20 @@ static long recv_raw(struct mg_connection *c, void *buf, size_t len) {
   if (MG_SOCK_PENDING(n)) return MG_IO_WAIT;
   if (MG_SOCK_RESET(n)) return MG_IO_RESET;  // MbedTLS, see #1507
   if (n <= 0) return MG_IO_ERR;
+  MG_STATS_ADD(c, bytes_in, (uint64_t) n);
   return n;
 }
 
 static bool ioalloc(struct mg_connection *c, struct mg_iobuf *io) {
   bool res = false;
-  if (io->len >= MG_MAX_RECV_SIZE) {
+  if (io->len >= MG_RECV_MAX(c)) {
     mg_error(c, "MG_MAX_RECV_SIZE");
-  } else if (io->size <= io->len &&
-             !mg_iobuf_resize(io, io->size + MG_IO_SIZE)) {
+  } else if (io->size > io->len) {
+    res = true;
+  } else if (!mg_iobuf_resize(io, io->size + MG_IO_SIZE)) {
     mg_error(c, "OOM");
   } else {
+    MG_STATS_ADD(c, allocs, 1);
     res = true;
   }
   return res;
@@ -9793,6 +10346,9 @@ static void close_conn(struct mg_connection *c) {
   if (FD(c) != MG_INVALID_SOCKET) {
 #if MG_ENABLE_EPOLL
     epoll_ctl(c->mgr->epoll_fd, EPOLL_CTL_DEL, FD(c), NULL);
+#endif
+#if MG_ENABLE_IO_URING
+    uring_forget(c);
 #endif
     closesocket(FD(c));
 #if MG_ENABLE_FREERTOS_TCP
@@ -9875,44 +10431,77 @@ void mg_connect_resolved(struct mg_connection *c) {
   }
 }
 
+// accept4() creates accepted sockets non-blocking and close-on-exec in
+// one syscall, instead of accept() followed by two fcntl() calls
+#if MG_ARCH == MG_ARCH_UNIX && defined(__linux__) && defined(SOCK_NONBLOCK)
+#define MG_ACCEPT4 1
+#ifndef _GNU_SOURCE
+int accept4(int, struct sockaddr *, socklen_t *, int);  // Needs _GNU_SOURCE
+#endif
+#else
+#define MG_ACCEPT4 0
+#endif
+
 static MG_SOCKET_TYPE raccept(MG_SOCKET_TYPE sock, union usa *usa,
                               socklen_t *len) {
   MG_SOCKET_TYPE fd = MG_INVALID_SOCKET;
   do {
     memset(usa, 0, sizeof(*usa));
+#if MG_ACCEPT4
+    fd = accept4(sock, &usa->sa, len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
     fd = accept(sock, &usa->sa, len);
+#endif
   } while (MG_SOCK_INTR(fd));
   return fd;
 }
 
-static void accept_conn(struct mg_mgr *mgr, struct mg_connection *lsn) {
-  struct mg_connection *c = NULL;
-  union usa usa;
-  socklen_t sa_len = sizeof(usa);
-  MG_SOCKET_TYPE fd = raccept(FD(lsn), &usa, &sa_len);
-  if (fd == MG_INVALID_SOCKET) {
-#if MG_ARCH == MG_ARCH_THREADX || defined(__ECOS)
-    // NetxDuo, in non-block socket mode can mark listening socket readable
-    // even it is not. See comment for 'select' func implementation in
-    // nx_bsd.c That's not an error, just should try later
-    if (errno != EAGAIN)
+// Check how full the listen queue is. Linux only: for listening sockets,
+// tcpi_unacked is the accept queue length and tcpi_sacked is its limit.
+// A full queue means the kernel may be dropping connections, but how many
+// it dropped is only in the system-wide ListenOverflows counter
+static void backlog_check(struct mg_mgr *mgr, struct mg_connection *lsn) {
+#if MG_ARCH == MG_ARCH_UNIX && defined(__linux__) && defined(TCP_INFO)
+  struct tcp_info ti;
+  socklen_t n = sizeof(ti);
+  memset(&ti, 0, sizeof(ti));
+  if (getsockopt(FD(lsn), IPPROTO_TCP, TCP_INFO, &ti, &n) == 0) {
+    if (ti.tcpi_unacked > mgr->accepts.peak_backlog) {
+      mgr->accepts.peak_backlog = ti.tcpi_unacked;
+    }
+    if (ti.tcpi_sacked > 0 && ti.tcpi_unacked >= ti.tcpi_sacked) {
+      mgr->accepts.full_samples++;
+    }
+  }
+#else
+  (void) mgr, (void) lsn;
 #endif
-      MG_ERROR(("%lu accept failed, errno %d", lsn->id, MG_SOCK_ERR(-1)));
+}
+
+static void accept_fd(struct mg_mgr *mgr, struct mg_connection *lsn,
+                      MG_SOCKET_TYPE fd, union usa *usa, socklen_t sa_len) {
+  struct mg_connection *c = NULL;
 #if (MG_ARCH != MG_ARCH_WIN32) && !MG_ENABLE_FREERTOS_TCP && \
     (MG_ARCH != MG_ARCH_TIRTOS) && !MG_ENABLE_POLL && !MG_ENABLE_EPOLL
-  } else if ((long) fd >= FD_SETSIZE) {
+  if ((long) fd >= FD_SETSIZE) {
     MG_ERROR(("%ld > %ld", (long) fd, (long) FD_SETSIZE));
     closesocket(fd);
+    return;
+  }
 #endif
-  } else if ((c = mg_alloc_conn(mgr)) == NULL) {
+  if ((c = mg_alloc_conn(mgr)) == NULL) {
     MG_ERROR(("%lu OOM", lsn->id));
     closesocket(fd);
   } else {
-    tomgaddr(&usa, &c->rem, sa_len != sizeof(usa.sin));
+    mgr->accepts.accepted++;
+    mgr->accepts.window_count++;
+    tomgaddr(usa, &c->rem, sa_len != sizeof(usa->sin));
     LIST_ADD_HEAD(struct mg_connection, &mgr->conns, c);
     c->fd = S2PTR(fd);
     MG_EPOLL_ADD(c);
+#if !MG_ACCEPT4
     mg_set_non_blocking_mode(FD(c));
+#endif
     setsockopts(c);
     c->is_accepted = 1;
     c->is_hexdumping = lsn->is_hexdumping;
@@ -9930,6 +10519,34 @@ static void accept_conn(struct mg_mgr *mgr, struct mg_connection *lsn) {
   }
 }
 
+// Drain the listen queue, up to MG_ACCEPT_BUDGET connections per poll
+// iteration, so a reconnect storm doesn't wait one loop cycle per client
+static void accept_conn(struct mg_mgr *mgr, struct mg_connection *lsn) {
+  int i;
+  backlog_check(mgr, lsn);
+  for (i = 0; i < MG_ACCEPT_BUDGET; i++) {
+    union usa usa;
+    socklen_t sa_len = sizeof(usa);
+    MG_SOCKET_TYPE fd = raccept(FD(lsn), &usa, &sa_len);
+    if (fd == MG_INVALID_SOCKET) {
+      if (MG_SOCK_PENDING(-1)) break;  // Listen queue is empty
+#if MG_ARCH == MG_ARCH_THREADX || defined(__ECOS)
+      // NetxDuo, in non-block socket mode can mark listening socket readable
+      // even it is not. See comment for 'select' func implementation in
+      // nx_bsd.c That's not an error, just should try later
+      if (errno != EAGAIN)
+#endif
+      {
+        mgr->accepts.failed++;  // E.g. EMFILE, the client stays queued
+        MG_ERROR(("%lu accept failed, errno %d", lsn->id, MG_SOCK_ERR(-1)));
+      }
+      break;
+    }
+    accept_fd(mgr, lsn, fd, &usa, sa_len);
+  }
+  if (i == MG_ACCEPT_BUDGET) mgr->accepts.budget_hits++;
+}
+
 static bool can_read(const struct mg_connection *c) {
   return c->is_full == false;
 }
@@ -9943,7 +10560,157 @@ static bool skip_iotest(const struct mg_connection *c) {
          (can_read(c) == false && can_write(c) == false);
 }
 
+#if MG_ENABLE_IO_URING
+static void uring_arm(struct mg_uring *u, struct mg_connection *c,
+                      struct mg_uring_slot *s) {
+  struct io_uring_sqe *sqe;
+  if (c->is_listening && !c->is_udp) {
+    if (!(s->flags & MG_URING_ARMED) &&
+        (sqe = uring_sqe(u, MG_URING_UD(MG_URING_ACCEPT, c))) != NULL) {
+      sqe->opcode = IORING_OP_ACCEPT;
+      sqe->fd = FD(c);
+      sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+      sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+      s->flags |= MG_URING_ARMED;
+    }
+  } else if (c->is_udp || c->is_connecting) {
+    // UDP needs the peer address, so it is read by read_conn() as before
+    if (!c->is_connecting && can_read(c) && !(s->flags & MG_URING_ARMED_IN) &&
+        (sqe = uring_sqe(u, MG_URING_UD(MG_URING_POLLIN, c))) != NULL) {
+      sqe->opcode = IORING_OP_POLL_ADD;
+      sqe->fd = FD(c);
+      sqe->poll32_events = POLLIN;
+      s->flags |= MG_URING_ARMED_IN;
+    }
+  } else if (can_read(c) && !(s->flags & (MG_URING_ARMED | MG_URING_EOF)) &&
+             (sqe = uring_sqe(u, MG_URING_UD(MG_URING_RECV, c))) != NULL) {
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = FD(c);
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    s->flags |= MG_URING_ARMED;
+  }
+  if (can_write(c) && !(s->flags & MG_URING_ARMED_OUT) &&
+      (sqe = uring_sqe(u, MG_URING_UD(MG_URING_POLLOUT, c))) != NULL) {
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = FD(c);
+    sqe->poll32_events = POLLOUT;
+    s->flags |= MG_URING_ARMED_OUT;
+  }
+}
+
+static bool uring_ready(struct mg_connection *c, struct mg_uring_slot *s) {
+  return can_read(c) &&
+         ((s->flags & (MG_URING_NEW | MG_URING_EOF)) ||
+          (!c->is_tls && c->rtls.len > 0) || mg_tls_pending(c) > 0);
+}
+
+static void uring_stage(struct mg_connection *c, struct mg_uring_slot *s,
+                        const void *buf, size_t len) {
+  size_t size = c->rtls.size;
+  if (c->rtls.len + len > MG_RECV_MAX(c)) {
+    mg_error(c, "MG_MAX_RECV_SIZE");
+  } else if (mg_iobuf_add(&c->rtls, c->rtls.len, buf, len) != len) {
+    mg_error(c, "OOM");
+  } else {
+    if (c->rtls.size != size) MG_STATS_ADD(c, allocs, 1);
+    MG_STATS_ADD(c, bytes_in, len);
+    s->flags |= MG_URING_NEW;
+  }
+}
+
+static void uring_cqe(struct mg_mgr *mgr, struct mg_uring *u,
+                      const struct io_uring_cqe *cqe) {
+  unsigned op = (unsigned) (cqe->user_data & 15);
+  size_t fd = (size_t) ((cqe->user_data >> 4) & 0xffffff);
+  uint64_t id = cqe->user_data >> 28;
+  struct mg_uring_slot *s = fd < u->nslots ? &u->slots[fd] : NULL;
+  struct mg_connection *c = s == NULL ? NULL : s->c;
+  bool more = cqe->flags & IORING_CQE_F_MORE;
+  if (c != NULL && (((uint64_t) c->id << 28) >> 28) != id) c = NULL;  // Stale
+  if (op == MG_URING_RECV && (cqe->flags & IORING_CQE_F_BUFFER)) {
+    unsigned short bid = (unsigned short) (cqe->flags >> 16);
+    if (c != NULL && cqe->res > 0) {
+      uring_stage(c, s, &u->bufs[(size_t) bid * MG_IO_URING_BUF_SIZE],
+                  (size_t) cqe->res);
+    }
+    uring_buf_put(u, bid);  // Data is copied, recycle the buffer
+  }
+  if (c == NULL || op == MG_URING_CANCEL) {
+    if (op == MG_URING_ACCEPT && cqe->res >= 0) close(cqe->res);
+  } else if (op == MG_URING_ACCEPT) {
+    if (!more) s->flags &= ~(unsigned) MG_URING_ARMED;
+    if (cqe->res >= 0) {
+      union usa usa;
+      socklen_t n = sizeof(usa);
+      memset(&usa, 0, sizeof(usa));
+      getpeername(cqe->res, &usa.sa, &n);
+      accept_fd(mgr, c, (MG_SOCKET_TYPE) cqe->res, &usa, n);
+    } else if (cqe->res != -ECANCELED) {
+      MG_ERROR(("%lu accept failed, errno %d", c->id, -cqe->res));
+    }
+  } else if (op == MG_URING_RECV) {
+    if (!more) s->flags &= ~(unsigned) MG_URING_ARMED;
+    // ENOBUFS means we ran out of provided buffers, just re-arm later
+    if (cqe->res == 0 || (cqe->res < 0 && cqe->res != -ENOBUFS)) {
+      s->flags |= MG_URING_EOF;
+    }
+  } else if (op == MG_URING_POLLIN || op == MG_URING_POLLOUT) {
+    s->flags &= ~(unsigned) (op == MG_URING_POLLIN ? MG_URING_ARMED_IN
+                                                   : MG_URING_ARMED_OUT);
+    if (cqe->res > 0 && (cqe->res & POLLERR)) {
+      mg_error(c, "socket error");
+    } else if (cqe->res > 0 && op == MG_URING_POLLIN) {
+      c->is_readable = can_read(c) ? 1U : 0;
+    } else if (cqe->res > 0) {
+      c->is_writable = can_write(c) ? 1U : 0;
+    }
+  }
+}
+
+// Returns false if io_uring is not in use, and a fallback should be used
+static bool uring_iotest(struct mg_mgr *mgr, int ms) {
+  struct mg_uring *u = (struct mg_uring *) mgr->uring;
+  struct mg_connection *c;
+  unsigned head, tail;
+  if (u == NULL) return false;
+  for (c = mgr->conns; c != NULL; c = c->next) {
+    struct mg_uring_slot *s;
+    c->is_readable = c->is_writable = 0;
+    if (c->is_closing) ms = 0;
+    if (c->is_closing || c->is_resolving || FD(c) == MG_INVALID_SOCKET) {
+      continue;
+    } else if ((s = uring_slot(u, c)) == NULL) {
+      mg_error(c, "OOM");
+    } else {
+      uring_arm(u, c, s);
+      if (uring_ready(c, s)) ms = 0;  // Staged data is waiting, don't sleep
+    }
+  }
+  if (uring_enter(u, 1, ms) < 0 && errno != ETIME && errno != EINTR &&
+      errno != EBUSY) {
+    MG_ERROR(("io_uring_enter: %d", errno));
+  }
+  head = *u->cq_head;
+  tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+  for (; head != tail; head++) uring_cqe(mgr, u, &u->cqes[head & *u->cq_mask]);
+  __atomic_store_n(u->cq_head, head, __ATOMIC_RELEASE);
+  for (c = mgr->conns; c != NULL; c = c->next) {
+    size_t fd = (size_t) FD(c);
+    struct mg_uring_slot *s = fd < u->nslots ? &u->slots[fd] : NULL;
+    if (s == NULL || s->c != c || c->is_closing) continue;
+    if (uring_ready(c, s)) c->is_readable = 1;
+    s->flags &= ~(unsigned) MG_URING_NEW;
+  }
+  return true;
+}
+#endif
+
 static void mg_iotest(struct mg_mgr *mgr, int ms) {
+#if MG_ENABLE_IO_URING
+  if (uring_iotest(mgr, ms)) return;
+#endif
 #if MG_ENABLE_FREERTOS_TCP
   struct mg_connection *c;
   for (c = mgr->conns; c != NULL; c = c->next) {
@@ -10167,13 +10934,43 @@ bool mg_wakeup(struct mg_mgr *mgr, unsigned long conn_id, const void *buf,
   return false;
 }
 
+#if MG_ENABLE_IDLE_RELEASE
+// Give IO buffers back once they are empty and the connection did no IO for
+// MG_IDLE_RELEASE_MS, so quiet connections don't hold MG_IO_SIZE bytes each.
+// Connections with traffic in between keep their buffers, instead of
+// reallocating them after every poll iteration that happened to have no IO
+static void release_idle(struct mg_connection *c, uint64_t now) {
+  if (c->is_readable || c->is_writable || c->recv.len > 0 ||
+      c->send.len > 0 || c->rtls.len > 0) {
+    c->io_ms = (uint32_t) now;
+  } else if ((uint32_t) now - c->io_ms >= MG_IDLE_RELEASE_MS) {
+    if (c->recv.size > 0) mg_iobuf_free(&c->recv);
+    if (c->rtls.size > 0) mg_iobuf_free(&c->rtls);
+    if (c->send.size > 0) mg_iobuf_free(&c->send);
+  }
+}
+#endif
+
 void mg_mgr_poll(struct mg_mgr *mgr, int ms) {
   struct mg_connection *c, *tmp;
   uint64_t now;
+#if MG_ENABLE_METRICS
+  uint64_t t0;
+#endif
 
   mg_iotest(mgr, ms);
+#if MG_ENABLE_METRICS
+  t0 = mg_micros();  // Time the processing, not the wait for IO
+#endif
   now = mg_millis();
   mg_timer_poll(&mgr->timers, now);
+  if (now >= mgr->accepts.window_start + 1000) {  // Update accepts per second
+    uint64_t elapsed = now - mgr->accepts.window_start;
+    mgr->accepts.rate =
+        (unsigned long) (mgr->accepts.window_count * 1000 / elapsed);
+    mgr->accepts.window_count = 0;
+    mgr->accepts.window_start = now;
+  }
 
   for (c = mgr->conns; c != NULL; c = tmp) {
     bool is_resp = c->is_resp;
@@ -10200,9 +10997,17 @@ void mg_mgr_poll(struct mg_mgr *mgr, int ms) {
       if (c->is_tls && !c->is_tls_hs && c->send.len == 0) mg_tls_flush(c);
     }
 
+#if MG_ENABLE_IDLE_RELEASE
+    if (!c->is_closing) release_idle(c, now);
+#endif
     if (c->is_draining && c->send.len == 0) c->is_closing = 1;
     if (c->is_closing) close_conn(c);
   }
+#if MG_ENABLE_METRICS
+  t0 = mg_micros() - t0;
+  mgr->stats.poll_us += t0;
+  mg_stats_hist(mgr->stats.poll_hist, t0);
+#endif
 }
 #endif
 
@@ -11934,6 +12739,7 @@ static void mg_tls_drop_record(struct mg_connection *c) {
   struct mg_iobuf *rio = &c->rtls;
   uint16_t n = MG_LOAD_BE16(rio->buf + 3) + TLS_RECHDR_SIZE;
   mg_iobuf_del(rio, 0, n);
+  MG_STATS_ADD(c, tls_in, 1);
 }
 
 // Remove a single TLS message from decrypted buffer, remove the wrapping
@@ -12153,6 +12959,7 @@ static bool mg_tls_encrypt(struct mg_connection *c, const uint8_t *msg,
 #endif
   c->is_client ? tls->enc.cseq++ : tls->enc.sseq++;
   wio->len += encsz;
+  MG_STATS_ADD(c, tls_out, 1);
   return true;
 }
 
@@ -15291,6 +16098,21 @@ static int mg_bio_write(BIO *bio, const char *buf, int len) {
   return len;
 }
 
+#if MG_TLS == MG_TLS_OPENSSL && MG_ENABLE_METRICS && defined(SSL3_RT_HEADER)
+// Called for every protocol message, count record headers only
+static void mg_tls_msg_cb(int write_p, int version, int content_type,
+                          const void *buf, size_t len, SSL *ssl, void *arg) {
+  struct mg_connection *c = (struct mg_connection *) arg;
+  if (content_type != SSL3_RT_HEADER) return;
+  if (write_p) {
+    MG_STATS_ADD(c, tls_out, 1);
+  } else {
+    MG_STATS_ADD(c, tls_in, 1);
+  }
+  (void) version, (void) buf, (void) len, (void) ssl;
+}
+#endif
+
 #ifdef MG_TLS_SSLKEYLOGFILE
 static void ssl_keylog_cb(const SSL *ssl, const char *line) {
   char *keylogfile = getenv("SSLKEYLOGFILE");
@@ -15397,6 +16219,14 @@ void mg_tls_init(struct mg_connection *c, const struct mg_tls_opts *opts) {
   }
 
   SSL_set_mode(tls->ssl, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+#if MG_TLS == MG_TLS_OPENSSL && MG_ENABLE_METRICS && defined(SSL3_RT_HEADER)
+  SSL_set_msg_callback(tls->ssl, mg_tls_msg_cb);
+  SSL_set_msg_callback_arg(tls->ssl, c);
+#endif
+#if MG_TLS == MG_TLS_OPENSSL && MG_ENABLE_IDLE_RELEASE
+  // Free OpenSSL record buffers (~34k) while the connection is idle
+  SSL_set_mode(tls->ssl, SSL_MODE_RELEASE_BUFFERS);
+#endif
 #if MG_TLS == MG_TLS_OPENSSL && OPENSSL_VERSION_NUMBER > 0x10002000L
   (void) SSL_set_ecdh_auto(tls->ssl, 1);
 #endif
@@ -17084,7 +17914,7 @@ int mg_rsa_mod_pow(const uint8_t *mod, size_t modsz, const uint8_t *exp, size_t
 
 
 
-#if MG_TLS == MG_TLS_BUILTIN
+#if MG_TLS == MG_TLS_BUILTIN || MG_ENABLE_UECC
 
 #ifndef MG_UECC_RNG_MAX_TRIES
 #define MG_UECC_RNG_MAX_TRIES 64
@@ -20302,7 +21132,7 @@ void mg_uecc_point_mult(mg_uecc_word_t *result, const mg_uecc_word_t *point,
 }
 
 #endif  /* MG_UECC_ENABLE_VLI_API */
-#endif  // MG_TLS_BUILTIN
+#endif  // MG_TLS_BUILTIN || MG_ENABLE_UECC
 // End of uecc BSD-2
 
 #ifdef MG_ENABLE_LINES
@@ -20860,6 +21690,22 @@ uint64_t mg_millis(void) {
 }
 #endif
 
+// Used for metrics, where the vDSO-backed CLOCK_MONOTONIC keeps the cost of
+// a reading in the tens of nanoseconds. Elsewhere, fall back to mg_millis()
+uint64_t mg_micros(void) {
+#if MG_ARCH == MG_ARCH_UNIX && defined(CLOCK_MONOTONIC) && !defined(__APPLE__)
+  struct timespec ts = {0, 0};
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t) ts.tv_sec * 1000000 + (uint64_t) ts.tv_nsec / 1000);
+#elif MG_ARCH == MG_ARCH_UNIX && defined(__APPLE__)
+  return clock_gettime_nsec_np(CLOCK_UPTIME_RAW) / 1000;
+#elif MG_ARCH == MG_ARCH_PICOSDK
+  return time_us_64();
+#else
+  return mg_millis() * 1000;
+#endif
+}
+
 // network format equates big endian order
 uint16_t mg_ntohs(uint16_t net) {
   return MG_LOAD_BE16(&net);
@@ -20948,8 +21794,17 @@ struct ws_msg {
 
 size_t mg_ws_vprintf(struct mg_connection *c, int op, const char *fmt,
                      va_list *ap) {
-  size_t len = c->send.len;
-  size_t n = mg_vxprintf(mg_pfn_iobuf, &c->send, fmt, ap);
+  size_t len = c->send.len, n;
+  if (c->send_high > 0) {
+    // Format aside, so that mg_ws_send() checks room for the whole frame.
+    // Return 0 if it was not queued, see mg_ws_would_block()
+    struct mg_iobuf io = {0, 0, 0, 256};
+    n = mg_vxprintf(mg_pfn_iobuf, &io, fmt, ap);
+    if (io.len != n || mg_ws_send(c, io.buf, io.len, op) == 0) n = 0;
+    mg_iobuf_free(&io);
+    return n;
+  }
+  n = mg_vxprintf(mg_pfn_iobuf, &c->send, fmt, ap);
   mg_ws_wrap(c, c->send.len - len, op);
   return n;
 }
@@ -20994,8 +21849,9 @@ static uint32_t be32(const uint8_t *p) {
          (((uint32_t) p[1]) << 16) | (((uint32_t) p[0]) << 24);
 }
 
-static size_t ws_process(uint8_t *buf, size_t len, struct ws_msg *msg) {
-  size_t i, n = 0, mask_len = 0;
+// Parse frame header. Return true if the whole frame is in the buffer
+static bool ws_header(const uint8_t *buf, size_t len, struct ws_msg *msg) {
+  size_t n = 0, mask_len = 0;
   memset(msg, 0, sizeof(*msg));
   if (len >= 2) {
     n = buf[1] & 0x7f;                // Frame length
@@ -21015,8 +21871,13 @@ static size_t ws_process(uint8_t *buf, size_t len, struct ws_msg *msg) {
   }
   // Sanity check, and integer overflow protection for the boundary check below
   // data_len should not be larger than 1 Gb
-  if (msg->data_len > 1024 * 1024 * 1024) return 0;
-  if (msg->header_len + msg->data_len > len) return 0;
+  if (msg->data_len > 1024 * 1024 * 1024) return false;
+  return msg->header_len + msg->data_len <= len;
+}
+
+static size_t ws_process(uint8_t *buf, size_t len, struct ws_msg *msg) {
+  size_t i, mask_len = len >= 2 && (buf[1] & 128) ? 4 : 0;
+  if (!ws_header(buf, len, msg)) return 0;
   if (mask_len > 0) {
     uint8_t *p = buf + msg->header_len, *m = p - mask_len;
     for (i = 0; i < msg->data_len; i++) p[i] ^= m[i & 3];
@@ -21024,6 +21885,94 @@ static size_t ws_process(uint8_t *buf, size_t len, struct ws_msg *msg) {
   return msg->header_len + msg->data_len;
 }
 
+// Spill to disk, see mg_recv_limits(). The payload of a data frame that
+// makes its message longer than the threshold, and of the frames that
+// continue that message, is unmasked and written to a file as it arrives.
+// Return true when c->recv holds nothing more to process for now
+static bool ws_spill(struct mg_connection *c, size_t *ofs) {
+  struct mg_spill *sp = c->spill;
+  *ofs = (size_t) c->pfn_data;
+  if (sp == NULL) return false;
+  for (;;) {
+    size_t i, n;
+    uint8_t *p;
+    if (!sp->in_frame) {
+      struct ws_msg msg;
+      uint8_t *buf = c->recv.buf + *ofs, op;
+      ws_header(buf, c->recv.len - *ofs, &msg);
+      op = msg.flags & 15;
+      if (msg.header_len == 0) return false;  // Incomplete header
+      if (op == WEBSOCKET_OP_CONTINUE) {
+        if (sp->fd == NULL && *ofs + msg.data_len <= sp->threshold) return false;
+      } else if ((op != WEBSOCKET_OP_TEXT && op != WEBSOCKET_OP_BINARY) ||
+                 sp->fd != NULL || msg.data_len <= sp->threshold) {
+        return false;
+      }
+      if (sp->fd == NULL) {
+        char rnd[17];
+        mg_random_str(rnd, sizeof(rnd));
+        mg_snprintf(sp->path, sizeof(sp->path), "%s%c.mg-spill-%s", sp->dir,
+                    MG_DIRSEP, rnd);
+        if ((sp->fd = mg_fs_posix.op(sp->path, MG_FS_WRITE)) == NULL) {
+          mg_error(c, "spill %s", sp->path);
+          return true;
+        }
+        sp->size = 0;
+        sp->flags = msg.flags;
+        if (*ofs > 0) {
+          // Earlier fragments, kept by mg_ws_cb(): first frame flags, data
+          sp->flags = c->recv.buf[0];
+          sp->size = *ofs - 1;
+          if (mg_fs_posix.wr(sp->fd, c->recv.buf + 1, sp->size) != sp->size) {
+            mg_error(c, "spill write");
+            return true;
+          }
+          mg_iobuf_del(&c->recv, 0, *ofs);
+          *ofs = 0;
+          c->pfn_data = NULL;
+          buf = c->recv.buf;
+        }
+      }
+      sp->left = msg.data_len;
+      sp->pos = 0;
+      sp->masked = (buf[1] & 128) != 0;
+      if (sp->masked) memcpy(sp->mask, buf + msg.header_len - 4, 4);
+      sp->fin = (msg.flags & 128) != 0;
+      sp->in_frame = true;
+      mg_iobuf_del(&c->recv, *ofs, msg.header_len);
+    }
+
+    n = c->recv.len - *ofs;
+    if (n > sp->left) n = sp->left;
+    p = c->recv.buf + *ofs;
+    if (sp->masked) {
+      for (i = 0; i < n; i++) p[i] ^= sp->mask[(sp->pos + i) & 3];
+    }
+    if (n > 0 && mg_fs_posix.wr(sp->fd, p, n) != n) {
+      mg_error(c, "spill write");
+      return true;
+    }
+    mg_iobuf_del(&c->recv, *ofs, n);
+    sp->left -= n, sp->pos += n, sp->size += n;
+    if (sp->left > 0) return true;  // Wait for the rest of the frame
+
+    sp->in_frame = false;
+    if (sp->fin) {
+      char path[MG_PATH_MAX];  // The handler may free sp
+      struct mg_ws_file f;
+      mg_fs_posix.cl(sp->fd);
+      sp->fd = NULL;
+      memcpy(path, sp->path, sizeof(path));
+      f.path = mg_str(path);
+      f.size = sp->size;
+      f.flags = sp->flags;
+      mg_call(c, MG_EV_WS_FILE, &f);
+      mg_fs_posix.rm(path);  // Unless the handler moved it
+      if (c->spill != sp) return true;
+    }
+  }
+}
+
 static size_t mkhdr(size_t len, int op, bool is_client, uint8_t *buf) {
   size_t n = 0;
   buf[0] = (uint8_t) (op | 128);
@@ -21064,13 +22013,64 @@ size_t mg_ws_send(struct mg_connection *c, const void *buf, size_t len,
                   int op) {
   uint8_t header[14];
   size_t header_len = mkhdr(len, op, c->is_client, header);
+  // Check for the whole frame, so that header and data are queued together
+  if (!mg_send_room(c, header_len + len)) return 0;
   if (!mg_send(c, header, header_len)) return 0;
   if (!mg_send(c, buf, len)) return header_len;
   MG_VERBOSE(("WS out: %d [%.*s]", (int) len, (int) len, buf));
   mg_ws_mask(c, len);
+  MG_STATS_ADD(c, frames_out, 1);
   return header_len + len;
 }
 
+// True if the last mg_ws_send() returned 0 because the send buffer is full
+bool mg_ws_would_block(const struct mg_connection *c) {
+  return c->is_send_high && !c->is_closing;
+}
+
+// Length of the whole frame queued at buf, or 0 if it is not a valid frame
+static size_t ws_frame_len(const uint8_t *buf, size_t len) {
+  struct ws_msg msg;
+  return ws_header(buf, len, &msg) ? msg.header_len + msg.data_len : 0;
+}
+
+// len bytes of c->send were written to the network. Track how much of the
+// frame at the head of c->send remains unsent, as that frame must be kept
+void mg_ws_sent(struct mg_connection *c, size_t len) {
+  size_t ofs = c->send_head;
+  while (ofs < len) {
+    size_t n = ws_frame_len(c->send.buf + ofs, c->send.len - ofs);
+    if (n == 0) {
+      ofs = c->send.len;  // Not framed data, stop dropping anything queued
+    } else {
+      ofs += n;
+    }
+  }
+  c->send_head = (uint32_t) (ofs - len);
+}
+
+// Drop the oldest unsent data frames, until len more bytes fit below the
+// high watermark. Partially sent, fragmented and control frames are kept.
+// Not used with TLS, as the TLS stack may have already consumed queued data.
+// Return the number of dropped bytes
+size_t mg_ws_drop(struct mg_connection *c, size_t len) {
+  size_t ofs = c->send_head, dropped = 0;
+  if (c->is_tls) return 0;
+  while (c->send.len + len > c->send_high && ofs < c->send.len) {
+    size_t n = ws_frame_len(c->send.buf + ofs, c->send.len - ofs);
+    uint8_t op = c->send.buf[ofs] & 15, fin = c->send.buf[ofs] & 128;
+    if (n == 0) break;
+    if (op >= WEBSOCKET_OP_CLOSE || op == WEBSOCKET_OP_CONTINUE || !fin) {
+      ofs += n;
+    } else {
+      mg_iobuf_del(&c->send, ofs, n);
+      dropped += n;
+    }
+  }
+  if (dropped > 0) MG_DEBUG(("%lu dropped %lu bytes", c->id, dropped));
+  return dropped;
+}
+
 static bool mg_ws_client_handshake(struct mg_connection *c) {
   int n = mg_http_get_request_len(c->recv.buf, c->recv.len);
   if (n < 0) {
@@ -21082,6 +22082,7 @@ static bool mg_ws_client_handshake(struct mg_connection *c) {
       struct mg_http_message hm;
       if (mg_http_parse((char *) c->recv.buf, c->recv.len, &hm)) {
         c->is_websocket = 1;
+        c->send_head = (uint32_t) c->send.len;  // Data queued before WS
         mg_call(c, MG_EV_WS_OPEN, &hm);
       } else {
         mg_error(c, "ws handshake error");
@@ -21102,11 +22103,13 @@ static void mg_ws_cb(struct mg_connection *c, int ev, void *ev_data) {
   if (ev == MG_EV_READ) {
     if (c->is_client && !c->is_websocket && mg_ws_client_handshake(c)) return;
 
-    while (ws_process(c->recv.buf + ofs, c->recv.len - ofs, &msg) > 0) {
+    while (!ws_spill(c, &ofs) &&
+           ws_process(c->recv.buf + ofs, c->recv.len - ofs, &msg) > 0) {
       char *s = (char *) c->recv.buf + ofs + msg.header_len;
       struct mg_ws_message m = {{s, msg.data_len}, msg.flags};
       size_t len = msg.header_len + msg.data_len;
       uint8_t final = msg.flags & 128, op = msg.flags & 15;
+      MG_STATS_ADD(c, frames_in, 1);
       // MG_VERBOSE ("fin %d op %d len %d [%.*s]", final, op,
       //                       (int) m.data.len, (int) m.data.len, m.data.buf));
       switch (op) {
@@ -21208,6 +22211,7 @@ void mg_ws_upgrade(struct mg_connection *c, struct mg_http_message *hm,
     ws_handshake(c, wskey, wsproto, fmt, &ap);
     va_end(ap);
     c->is_websocket = 1;
+    c->send_head = (uint32_t) c->send.len;  // Handshake reply is not a frame
     c->is_resp = 0;
     mg_call(c, MG_EV_WS_OPEN, hm);
   }
@@ -21223,6 +22227,7 @@ size_t mg_ws_wrap(struct mg_connection *c, size_t len, int op) {
     memmove(p, p - header_len, len);             // Shift data
     memcpy(p - header_len, header, header_len);  // Prepend header
     mg_ws_mask(c, len);                          // Mask data
+    MG_STATS_ADD(c, frames_out, 1);
   }  // returning 0 means an OOM condition (iobuf couldn't resize), yet this is
   return c->send.len;  // so far recoverable, let the caller decide
 }
@@ -482,7 +482,10 @@ static inline int mg_mkdir(const char *path, mode_t mode) {
 #include <mach/mach_time.h>
 #endif
 
-#if !defined(MG_ENABLE_EPOLL) && defined(__linux__)
+#if defined(MG_ENABLE_IO_URING) && MG_ENABLE_IO_URING && defined(__linux__)
+#define MG_ENABLE_EPOLL 0  // io_uring replaces epoll, poll() is the fallback
+#define MG_ENABLE_POLL 1   // when the kernel refuses io_uring_setup()
+#elif !defined(MG_ENABLE_EPOLL) && defined(__linux__)
 #define MG_ENABLE_EPOLL 1
 #elif !defined(MG_ENABLE_POLL)
 #define MG_ENABLE_POLL 1
@@ -515,10 +518,17 @@ static inline int mg_mkdir(const char *path, mode_t mode) {
 #include <sys/select.h>
 #endif
 
+#if defined(MG_ENABLE_IO_URING) && MG_ENABLE_IO_URING && defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -922,6 +932,22 @@ struct timeval {
 #define MG_ENABLE_EPOLL 0
 #endif
 
+#ifndef MG_ENABLE_IO_URING
+#define MG_ENABLE_IO_URING 0  // Linux only. Multishot accept/recv via io_uring
+#endif
+
+#ifndef MG_IO_URING_ENTRIES
+#define MG_IO_URING_ENTRIES 1024  // io_uring submission queue size
+#endif
+
+#ifndef MG_IO_URING_BUFS
+#define MG_IO_URING_BUFS 1024  // Provided receive buffers, must be power of 2
+#endif
+
+#ifndef MG_IO_URING_BUF_SIZE
+#define MG_IO_URING_BUF_SIZE 4096  // Size of each provided receive buffer
+#endif
+
 #ifndef MG_ENABLE_FATFS
 #define MG_ENABLE_FATFS 0
 #endif
@@ -980,6 +1006,18 @@ struct timeval {
 #define MG_DATA_SIZE 32  // struct mg_connection :: data size
 #endif
 
+#ifndef MG_ENABLE_IDLE_RELEASE
+#define MG_ENABLE_IDLE_RELEASE 1  // Free empty IO buffers of idle connections
+#endif
+
+#ifndef MG_IDLE_RELEASE_MS
+#define MG_IDLE_RELEASE_MS 3000  // Keep IO buffers this long after the last IO
+#endif
+
+#ifndef MG_ENABLE_METRICS
+#define MG_ENABLE_METRICS 0  // Traffic counters and timings, see mg_mgr_stats()
+#endif
+
 #ifndef MG_MAX_HTTP_HEADERS
 #define MG_MAX_HTTP_HEADERS 30
 #endif
@@ -1000,6 +1038,10 @@ struct timeval {
 #define MG_SOCK_LISTEN_BACKLOG_SIZE 128
 #endif
 
+#ifndef MG_ACCEPT_BUDGET
+#define MG_ACCEPT_BUDGET 64  // Max connections accepted per listener per poll
+#endif
+
 #ifndef MG_DIRSEP
 #define MG_DIRSEP '/'
 #endif
@@ -1097,6 +1139,10 @@ struct timeval {
 #define MG_ENABLE_CHACHA20 1  // When set to 0, GCM is used. For MG_TLS_BUILTIN
 #endif
 
+#ifndef MG_ENABLE_UECC
+#define MG_ENABLE_UECC 1  // mg_uecc_*() ECDSA, also without MG_TLS_BUILTIN
+#endif
+
 
 
 // Macros to record timestamped events that happens with a connection.
@@ -1379,6 +1425,7 @@ bool mg_random(void *buf, size_t len);
 char *mg_random_str(char *buf, size_t len);
 uint32_t mg_crc32(uint32_t crc, const char *buf, size_t len);
 uint64_t mg_millis(void);  // Return milliseconds since boot
+uint64_t mg_micros(void);  // Return microseconds since boot
 bool mg_path_is_sane(const struct mg_str path);
 void mg_delayms(unsigned int ms);
 
@@ -1641,6 +1688,9 @@ enum {
   MG_EV_MQTT_OPEN,  // MQTT CONNACK received        int *connack_status_code
   MG_EV_SNTP_TIME,  // SNTP time received           uint64_t *epoch_millis
   MG_EV_WAKEUP,     // mg_wakeup() data received    struct mg_str *data
+  MG_EV_SEND_HIGH,  // c->send hit high watermark   NULL
+  MG_EV_SEND_LOW,   // c->send drained to low mark  NULL
+  MG_EV_WS_FILE,    // Websocket msg in a file      struct mg_ws_file *
   MG_EV_USER        // Starting ID for user events
 };
 
@@ -1669,6 +1719,54 @@ struct mg_addr {
   bool is_ip6;       // True when address is IPv6 address
 };
 
+// Traffic counters of a single connection, updated when MG_ENABLE_METRICS=1
+struct mg_conn_stats {
+  uint64_t bytes_in;    // Bytes read from the network, TLS overhead included
+  uint64_t bytes_out;   // Bytes written to the network, TLS overhead included
+  uint64_t handler_us;  // Time spent in event handlers, microseconds
+  uint32_t frames_in;   // WebSocket frames and HTTP messages received
+  uint32_t frames_out;  // WebSocket frames sent
+  uint32_t tls_in;      // TLS records received
+  uint32_t tls_out;     // TLS records sent
+  uint32_t allocs;      // IO buffer (re)allocations
+};
+
+// Latency histograms have a bucket per power of 2 microseconds: bucket i
+// counts durations below 2^i us, the last bucket counts everything above
+#define MG_STATS_BUCKETS 20
+
+// Listener statistics, socket builds only. Updated by mg_mgr_poll()
+struct mg_accept_stats {
+  uint64_t accepted;           // Total accepted connections
+  uint64_t failed;             // accept() errors, e.g. EMFILE
+  uint64_t budget_hits;        // Drains stopped by MG_ACCEPT_BUDGET
+  uint64_t full_samples;       // Drains that found the queue full. Linux only
+  unsigned long peak_backlog;  // Longest listen queue seen. Linux only
+  unsigned long rate;          // Accepts per second, during the last second
+  unsigned long window_count;  // Private. Accepts in the current second
+  uint64_t window_start;       // Private. Start of the current second
+};
+
+// Manager-wide metrics. mg_mgr_stats() fills it with the totals of closed
+// connections plus the current counters of the live ones, and a copy of
+// the listener statistics. Traffic counters and histograms stay zero unless
+// built with MG_ENABLE_METRICS=1: timing handlers costs two clock reads per
+// event
+struct mg_stats {
+  uint64_t bytes_in, bytes_out;    // See struct mg_conn_stats
+  uint64_t frames_in, frames_out;  // See struct mg_conn_stats
+  uint64_t tls_in, tls_out;        // See struct mg_conn_stats
+  uint64_t allocs;                 // See struct mg_conn_stats
+  uint64_t handler_us;             // Sum of handler_hist, microseconds
+  uint64_t poll_us;                // Sum of poll_hist, microseconds
+  uint64_t opened, closed;         // Connections opened and closed so far
+  unsigned long active;            // Connections currently open
+  uint32_t handler_hist[MG_STATS_BUCKETS];  // Event handler run times
+  uint32_t poll_hist[MG_STATS_BUCKETS];     // mg_mgr_poll() processing times
+  struct mg_accept_stats accepts;           // Copy of mgr->accepts
+  int depth;                                // Private. mg_call() nesting
+};
+
 struct mg_mgr {
   struct mg_connection *conns;  // List of active connections
   struct mg_dns dns4;           // DNS for IPv4
@@ -1682,31 +1780,29 @@ struct mg_mgr {
   void *active_dns_requests;    // DNS requests in progress
   struct mg_timer *timers;      // Active timers
   int epoll_fd;                 // Used when MG_EPOLL_ENABLE=1
+  void *uring;                  // Used when MG_ENABLE_IO_URING=1
   struct mg_tcpip_if *ifp;      // Builtin TCP/IP stack only. Interface pointer
   size_t extraconnsize;         // Builtin TCP/IP stack only. Extra space
   MG_SOCKET_TYPE pipe;          // Socketpair end for mg_wakeup()
+  struct mg_accept_stats accepts;  // Listener statistics
+  struct mg_stats stats;        // Private. Closed connections, histograms
 #if MG_ENABLE_FREERTOS_TCP
   SocketSet_t ss;  // NOTE(lsm): referenced from socket struct
 #endif
 };
 
+// Frequently used fields come first, so that mg_mgr_poll() touches as few
+// cache lines per connection as possible. With MG_ENABLE_IDLE_RELEASE, a
+// connection idle for MG_IDLE_RELEASE_MS owns no IO buffers: it costs
+// sizeof(struct mg_connection) plus malloc overhead, a few hundred bytes,
+// instead of ~33 KB with 16 KB recv and send buffers kept around.
+// MG_ENABLE_METRICS=1 adds the 48-byte struct mg_conn_stats to it. OpenSSL
+// adds its per-session state for TLS connections
 struct mg_connection {
   struct mg_connection *next;     // Linkage in struct mg_mgr :: connections
   struct mg_mgr *mgr;             // Our container
-  struct mg_addr loc;             // Local address
-  struct mg_addr rem;             // Remote address
   void *fd;                       // Connected socket, or LWIP data
   unsigned long id;               // Auto-incrementing unique connection ID
-  struct mg_iobuf recv;           // Incoming data
-  struct mg_iobuf send;           // Outgoing data
-  struct mg_iobuf prof;           // Profile data enabled by MG_ENABLE_PROFILE
-  struct mg_iobuf rtls;           // TLS only. Incoming encrypted data
-  mg_event_handler_t fn;          // User-specified event handler function
-  void *fn_data;                  // User-specified function parameter
-  mg_event_handler_t pfn;         // Protocol-specific handler function
-  void *pfn_data;                 // Protocol-specific function parameter
-  char data[MG_DATA_SIZE];        // Arbitrary connection data
-  void *tls;                      // TLS specific data
   unsigned is_listening : 1;      // Listening connection
   unsigned is_client : 1;         // Outbound (client) connection
   unsigned is_accepted : 1;       // Accepted (server) connection
@@ -1726,11 +1822,50 @@ struct mg_connection {
   unsigned is_resp : 1;           // Response is still being generated
   unsigned is_readable : 1;       // Connection is ready to read
   unsigned is_writable : 1;       // Connection is ready to write
+  unsigned is_send_high : 1;      // c->send is above the high watermark
+  unsigned send_policy : 2;       // MG_SEND_* policy, see mg_send_limits()
+  uint32_t send_high;             // c->send high watermark, 0 means no limit
+  uint32_t send_low;              // MG_EV_SEND_LOW is sent at or below this
+  uint32_t send_head;             // Private. Unsent bytes of first WS frame
+  uint32_t recv_max;              // c->recv cap, 0 means MG_MAX_RECV_SIZE
+#if MG_ENABLE_IDLE_RELEASE
+  uint32_t io_ms;                 // Private. Low bits of mg_millis() at last IO
+#endif
+  struct mg_spill *spill;         // Private. See mg_recv_limits()
+  struct mg_iobuf recv;           // Incoming data
+  struct mg_iobuf send;           // Outgoing data
+  struct mg_iobuf rtls;           // TLS only. Incoming encrypted data
+  mg_event_handler_t fn;          // User-specified event handler function
+  void *fn_data;                  // User-specified function parameter
+  mg_event_handler_t pfn;         // Protocol-specific handler function
+  void *pfn_data;                 // Protocol-specific function parameter
+  void *tls;                      // TLS specific data
+  struct mg_addr loc;             // Local address
+  struct mg_addr rem;             // Remote address
+  char data[MG_DATA_SIZE];        // Arbitrary connection data
+#if MG_ENABLE_METRICS
+  struct mg_conn_stats stats;  // Traffic counters, see mg_mgr_stats()
+#endif
+#if MG_ENABLE_PROFILE
+  struct mg_iobuf prof;  // Profile data enabled by MG_ENABLE_PROFILE
+#endif
 };
 
 void mg_mgr_poll(struct mg_mgr *, int ms);
 void mg_mgr_init(struct mg_mgr *);
 void mg_mgr_free(struct mg_mgr *);
+void mg_mgr_stats(struct mg_mgr *, struct mg_stats *);  // Take a snapshot
+size_t mg_print_stats_json(void (*out)(char, void *), void *arg, va_list *ap);
+size_t mg_print_stats_prom(void (*out)(char, void *), void *arg, va_list *ap);
+size_t mg_print_conn_stats(void (*out)(char, void *), void *arg, va_list *ap);
+void mg_stats_hist(uint32_t *hist, uint64_t us);  // Private
+void mg_stats_fold(struct mg_stats *, const struct mg_conn_stats *);  // Private
+
+#if MG_ENABLE_METRICS
+#define MG_STATS_ADD(c, field, n) ((c)->stats.field += (n))
+#else
+#define MG_STATS_ADD(c, field, n) ((void) 0)
+#endif
 
 struct mg_connection *mg_listen(struct mg_mgr *, const char *url,
                                 mg_event_handler_t fn, void *fn_data);
@@ -1740,6 +1875,33 @@ struct mg_connection *mg_wrapfd(struct mg_mgr *mgr, int fd,
                                 mg_event_handler_t fn, void *fn_data);
 void mg_connect_resolved(struct mg_connection *);
 bool mg_send(struct mg_connection *, const void *, size_t);
+
+// Send-side backpressure. When a connection has a high watermark, mg_send(),
+// mg_printf(), mg_ws_send() and mg_ws_printf() check it before queueing
+// data. Crossing it fires MG_EV_SEND_HIGH once, and draining to the low
+// watermark fires MG_EV_SEND_LOW. What happens to data that does not fit
+// depends on policy
+enum {
+  MG_SEND_PAUSE,        // Refuse it: mg_send() fails, mg_ws_send() returns 0
+  MG_SEND_DROP_OLDEST,  // Plain WebSocket: drop the oldest unsent messages
+  MG_SEND_DISCONNECT    // Close the slow consumer
+};
+void mg_send_limits(struct mg_connection *, size_t low, size_t high,
+                    int policy);
+bool mg_send_room(struct mg_connection *, size_t len);  // Private
+void mg_send_del(struct mg_connection *, size_t len);   // Private
+
+// Receive limits. c->recv never grows past max bytes; 0 restores
+// MG_MAX_RECV_SIZE. With spill > 0, WebSocket messages longer than spill
+// bytes are not kept in c->recv: their payload is written to a temporary
+// file in dir as it arrives, and the message is delivered as MG_EV_WS_FILE.
+// Temporary files are hidden, named .mg-spill-*; a crashed process leaves
+// them behind for the application to clean up
+bool mg_recv_limits(struct mg_connection *, size_t max, size_t spill,
+                    const char *dir);
+void mg_spill_free(struct mg_connection *);  // Private
+#define MG_RECV_MAX(c) \
+  ((c)->recv_max > 0 ? (size_t) (c)->recv_max : (size_t) MG_MAX_RECV_SIZE)
 size_t mg_printf(struct mg_connection *, const char *fmt, ...);
 size_t mg_vprintf(struct mg_connection *, const char *fmt, va_list *ap);
 bool mg_aton(struct mg_str str, struct mg_addr *addr);
@@ -1752,6 +1914,8 @@ bool mg_open_listener(struct mg_connection *c, const char *url);
 // Utility functions
 bool mg_wakeup(struct mg_mgr *, unsigned long id, const void *buf, size_t len);
 bool mg_wakeup_init(struct mg_mgr *);
+bool mg_uring_init(struct mg_mgr *);  // Private, MG_ENABLE_IO_URING only
+void mg_uring_free(struct mg_mgr *);  // Private, MG_ENABLE_IO_URING only
 struct mg_timer *mg_timer_add(struct mg_mgr *mgr, uint64_t milliseconds,
                               unsigned flags, void (*fn)(void *), void *arg);
 struct mg_connection *mg_connect_svc(struct mg_mgr *mgr, const char *url,
@@ -2783,12 +2947,26 @@ struct mg_ws_message {
   uint8_t flags;       // Websocket message flags
 };
 
+// A message spilled to disk, see mg_recv_limits(). The file is removed
+// after MG_EV_WS_FILE unless the handler renames it
+struct mg_ws_file {
+  struct mg_str path;  // Temporary file holding the payload
+  size_t size;         // Payload length
+  uint8_t flags;       // Websocket message flags
+};
+
 struct mg_connection *mg_ws_connect(struct mg_mgr *, const char *url,
                                     mg_event_handler_t fn, void *fn_data,
                                     const char *fmt, ...);
 void mg_ws_upgrade(struct mg_connection *, struct mg_http_message *,
                    const char *fmt, ...);
+// Return the number of bytes queued, header included, or 0 if the frame was
+// not queued. After 0, mg_ws_would_block() is true if that is because the
+// send buffer is full (see mg_send_limits()): retry after MG_EV_SEND_LOW
 size_t mg_ws_send(struct mg_connection *, const void *buf, size_t len, int op);
+bool mg_ws_would_block(const struct mg_connection *);
+size_t mg_ws_drop(struct mg_connection *, size_t len);  // Private
+void mg_ws_sent(struct mg_connection *, size_t len);    // Private
 size_t mg_ws_wrap(struct mg_connection *, size_t len, int op);
 size_t mg_ws_printf(struct mg_connection *c, int op, const char *fmt, ...);
 size_t mg_ws_vprintf(struct mg_connection *c, int op, const char *fmt,